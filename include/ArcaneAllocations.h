@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation accounting. With ARCANE_TRACK_ALLOCATIONS the global
+// operator new/delete are replaced by versions that count every allocation
+// on the calling thread, and the UI pool and frame arena get their memory
+// through countedAlloc/countedFree. Counting is a thread-local
+// add, with no locks or shared atomics. Without the flag nothing is replaced
+// and the totals stay zero.
+struct AllocationCount {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+bool allocationTrackingEnabled();
+
+// Running totals of the calling thread since it started
+AllocationCount threadAllocations();
+
+// Counted malloc/free in the shape ImGui::SetAllocatorFunctions takes
+void* countedAlloc(size_t size, void* user);
+void countedFree(void* ptr, void* user);
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Bump-pointer scratch memory for one frame of the UI. Allocating is a
+// pointer bump; nothing is freed one by one, the whole arena is rewound by
+// reset() at the start of the next frame (GUIRender::NewFrame). A frame
+// that outgrows the block chains another one, and the next reset() merges
+// them into a single block of the high-water size, so steady-state frames
+// reach the heap zero times. Frame thread only.
+class FrameArena {
+    public:
+        static const size_t BLOCK_BYTES = 64 * 1024;
+
+        // The UI's arena
+        static FrameArena& instance();
+
+        FrameArena() = default;
+        ~FrameArena();
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+
+        // Uninitialized room for `count` T, valid until the next reset()
+        template <typename T>
+        T* array(size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+            return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        }
+
+        // printf into the arena, e.g. for per-frame labels
+        const char* format(const char* fmt, ...)
+#if defined(__GNUC__)
+            __attribute__((format(printf, 2, 3)))
+#endif
+            ;
+
+        void reset();
+
+        size_t used() const { return usedBefore + offset; }
+        size_t highWater() const { return peak; }
+
+    private:
+        struct Block {
+            Block* previous;
+            size_t size; // usable bytes after the header
+        };
+
+        void grow(size_t bytes, size_t align);
+        static uint8_t* base(Block* block);
+
+        Block* current = nullptr;
+        size_t offset = 0;     // used bytes of current
+        size_t usedBefore = 0; // used bytes of the chained blocks before current
+        size_t peak = 0;
+};
+
+// Size-class pool for long-lived UI allocations (ImGui and ImPlot windows,
+// tables, vectors). Freed blocks go onto a free list of their class and are
+// handed out again, so days of opening and closing windows reuse the same
+// slabs instead of fragmenting the heap. Requests above the largest class go
+// straight to malloc. Like ImGui itself, one thread only.
+class PoolAllocator {
+    public:
+        static const size_t SLAB_BYTES = 64 * 1024;
+        static const size_t SIZE_CLASSES = 8; // 32 bytes to 4 KB in powers of two
+
+        // The pool behind ImGui::SetAllocatorFunctions
+        static PoolAllocator& ui();
+
+        PoolAllocator() = default;
+        ~PoolAllocator();
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        void* allocate(size_t bytes);
+        void release(void* ptr);
+
+        size_t slabBytes() const { return slabCount * SLAB_BYTES; }
+        size_t liveBlocks() const { return live; }
+
+        // ImGui::SetAllocatorFunctions shape; user is the PoolAllocator
+        static void* imguiAlloc(size_t bytes, void* user);
+        static void imguiFree(void* ptr, void* user);
+
+    private:
+        struct FreeBlock { FreeBlock* next; };
+
+        void refill(size_t sizeClass);
+
+        FreeBlock* freeLists[SIZE_CLASSES] = {};
+        void* slabs = nullptr; // chained through their first word
+        size_t slabCount = 0;
+        size_t live = 0;
+};
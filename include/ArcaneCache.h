@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+// Bounded LRU memo in front of ArcaneMath<T>::solve. Entries are keyed on the
+// known-mask plus the known inputs rounded to `tolerance`, so re-running the
+// same (or nearly the same) scenario returns the stored result without solving.
+template <typename T = float>
+class ArcaneSolveCache {
+    public:
+        explicit ArcaneSolveCache(size_t capacity = 1024, T tolerance = T(1e-4));
+
+        // Same contract as ArcaneMath<T>(data, known).solve() + writeToArray(data)
+        void solve(T data[8], bool known[8]);
+
+        // Changing the tolerance changes every key, so it also empties the cache
+        void setTolerance(T tolerance);
+        T getTolerance() const { return tolerance; }
+        void setCapacity(size_t capacity);
+        size_t getCapacity() const { return capacity; }
+
+        void clear();
+        size_t size() const { return entries.size(); }
+        size_t hits() const { return hitCount; }
+        size_t misses() const { return missCount; }
+        void resetCounters() { hitCount = missCount = 0; }
+
+    private:
+        struct Key {
+            unsigned mask;
+            int64_t q[8];
+            bool operator==(const Key& other) const;
+        };
+        struct KeyHash {
+            size_t operator()(const Key& key) const;
+        };
+        struct Entry {
+            Key key;
+            T result[8];
+            unsigned solvedMask; // values the solver wrote; the rest pass through
+        };
+
+        Key makeKey(const T data[8], const bool known[8]) const;
+        void evictToCapacity();
+
+        size_t capacity;
+        T tolerance;
+        size_t hitCount = 0;
+        size_t missCount = 0;
+
+        std::list<Entry> entries; // most recently used first
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> index;
+};
+
+extern template class ArcaneSolveCache<float>;
+extern template class ArcaneSolveCache<double>;
+extern template class ArcaneSolveCache<long double>;
@@ -0,0 +1,47 @@
+#pragma once
+
+// Fixed-step simulation clock. Scaled wall time accumulates and is handed out
+// in whole steps of stepSize(), so the physics sees the same dt at any frame
+// rate, and alpha() tells rendering how far it is between the last two steps.
+// One frame feeds in at most 0.25 s of wall time, so after a hitch (window
+// drag, breakpoint) the simulation falls behind wall time instead of jumping;
+// that time counts as dropped. maxStepsPerFrame can cap the steps further for
+// expensive steps; 0 leaves the wall-time clamp as the only budget, so any
+// frame rate and time scale keep up.
+class SimulationClock {
+    public:
+        explicit SimulationClock(double step = 1.0 / 240.0, int maxStepsPerFrame = 0);
+
+        // Simulation time back to 0, measuring wall time from wallNow
+        void start(double wallNow);
+        // Steps to run for the wall time since the last call
+        int advance(double wallNow);
+        // Queue one step for the next advance(), for stepping while paused
+        void stepOnce() { pendingSteps++; }
+
+        double time() const { return (double)stepCount * step; }
+        double alpha() const { return accumulator / step; }
+        double stepSize() const { return step; }
+        long long steps() const { return stepCount; }
+        double droppedSeconds() const { return dropped; }
+
+        // Resuming measures wall time from wallNow, so the time spent paused is
+        // neither simulated nor counted as dropped
+        void setPaused(bool value, double wallNow);
+        bool paused() const { return isPaused; }
+        // 1 = real time, < 1 slow motion, > 1 fast-forward
+        void setTimeScale(double value) { scale = value > 0.0 ? value : 0.0; }
+        double timeScale() const { return scale; }
+
+    private:
+        double step;
+        int maxSteps; // 0 = no cap beyond the wall-time clamp
+        double scale = 1.0;
+        bool isPaused = false;
+
+        double lastWall = 0.0;
+        double accumulator = 0.0;
+        long long stepCount = 0;
+        int pendingSteps = 0;
+        double dropped = 0.0;
+};
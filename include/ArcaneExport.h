@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ArcaneScheduler.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Write 8-bit RGBA pixels as a PNG (zlib stored blocks, no compression
+// library needed). bottomUp flips rows as they come from glReadPixels.
+bool writePng(const char* path, const uint8_t* rgba, int width, int height, bool bottomUp);
+
+enum class ExportFormat { Png, RawVideo };
+
+// Encodes captured frames as TaskScheduler tasks. Png writes one file per
+// frame in parallel; RawVideo appends top-down RGBA frames to one stream in
+// submission order (e.g. for ffmpeg -f rawvideo -pix_fmt rgba), one task at
+// a time draining the queue. Pixel buffers are recycled, and submit() blocks
+// while maxQueued frames are in flight, so memory stays bounded and a fast
+// renderer is throttled to the encoders.
+class FrameEncoder {
+    public:
+        // For RawVideo, path is the stream file; for Png it is unused.
+        // threads = 0 uses the shared scheduler.
+        FrameEncoder(ExportFormat format, const char* path, unsigned threads = 0, size_t maxQueued = 0);
+        ~FrameEncoder();
+        FrameEncoder(const FrameEncoder&) = delete;
+        FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+        bool ok() const { return !failed; }
+
+        // A buffer of width * height * 4 bytes to fill and submit
+        std::vector<uint8_t> acquire(int width, int height);
+        // Queue a bottom-up RGBA frame; pngPath names the file for Png
+        void submit(std::vector<uint8_t>&& pixels, int width, int height, const std::string& pngPath);
+        // Wait for every queued frame; false if any write failed
+        bool finish();
+
+        size_t framesWritten() const { return written; }
+
+    private:
+        struct Job {
+            std::vector<uint8_t> pixels;
+            int width, height;
+            std::string path;
+        };
+
+        void encodePng(Job& job);
+        void drainRaw();
+        void finishJob(Job& job, bool ok);
+
+        ExportFormat format;
+        FILE* stream = nullptr;
+        size_t maxQueued;
+
+        std::unique_ptr<TaskScheduler> ownScheduler;
+        std::unique_ptr<TaskGroup> tasks;
+
+        std::mutex mutex;
+        std::condition_variable jobDone;
+        std::deque<Job> rawQueue; // RawVideo frames not yet written, in order
+        bool rawDraining = false; // a drainRaw() task is running or queued
+        std::vector<std::vector<uint8_t>> spare;
+        size_t written = 0;
+        size_t inFlight = 0;
+        bool failed = false;
+};
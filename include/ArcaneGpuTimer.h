@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/glad.h>
+#include "ArcaneProfiler.h"
+#include <cstdint>
+
+// GL_TIME_ELAPSED queries around named render passes. Queries live in a ring
+// of FRAMES_IN_FLIGHT frames and a frame's results are read only once
+// GL_QUERY_RESULT_AVAILABLE says so, so timing never waits on the GPU; a
+// frame still pending when its slot comes round again is dropped instead.
+// Timer queries need GL 3.3 (the 3.2 context usually comes up newer);
+// without them every call is a no-op.
+class GpuTimer {
+    public:
+        static const int FRAMES_IN_FLIGHT = 4;
+        static const int MAX_PASSES = 8;
+        static const int HISTORY = 240;
+
+        static GpuTimer& instance();
+
+        bool init();     // after the GL context is current
+        void shutdown(); // while it still is
+        bool supported() const { return ready; }
+
+        // Read back finished frames and open the next ring slot
+        void beginFrame();
+        // Passes are sequential; GL_TIME_ELAPSED queries cannot nest
+        void begin(const char* pass);
+        void end();
+
+        // Passes seen so far, with their recent GPU times (ms)
+        int passCount() const { return passes; }
+        const char* passName(int pass) const { return names[pass]; }
+        float lastMs(int pass) const;
+        float meanMs(int pass) const;
+        float maxMs(int pass) const;
+        uint64_t droppedFrames() const { return dropped; }
+
+    private:
+        struct Slot {
+            GLuint queries[MAX_PASSES];
+            int pass[MAX_PASSES]; // index into names for each issued query
+            int issued = 0;
+            bool pending = false;
+        };
+
+        int passIndex(const char* pass);
+        void collect(Slot& slot);
+
+        bool ready = false;
+        Slot slots[FRAMES_IN_FLIGHT];
+        int current = 0;
+        bool open = false;
+
+        const char* names[MAX_PASSES];
+        int passes = 0;
+        float history[MAX_PASSES][HISTORY];
+        int samples[MAX_PASSES]; // results recorded per pass
+        uint64_t dropped = 0;
+};
+
+#ifdef ARCANE_ENABLE_PROFILING
+// Times the enclosing block on the GPU as `pass`
+class GpuScope {
+    public:
+        explicit GpuScope(const char* pass) { GpuTimer::instance().begin(pass); }
+        ~GpuScope() { GpuTimer::instance().end(); }
+        GpuScope(const GpuScope&) = delete;
+        GpuScope& operator=(const GpuScope&) = delete;
+};
+    #define ARCANE_GPU_SCOPE(pass) GpuScope ARCANE_PROFILE_CONCAT(gpuScope, __LINE__)(pass)
+#else
+    #define ARCANE_GPU_SCOPE(pass) ((void)0)
+#endif
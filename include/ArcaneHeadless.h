@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ArcaneExport.h"
+
+struct HeadlessOptions {
+    const char* scenarioPath = nullptr; // "v0,theta,h0,g" per line (theta in degrees)
+    const char* outDir = ".";
+    int width = 640;
+    int height = 360;
+    ExportFormat format = ExportFormat::Png;
+    unsigned threads = 0; // encoder threads, 0 = the shared scheduler
+    bool checkAllocations = false; // count steady-state frame allocations instead of exporting
+};
+
+// Render the full UI for every scenario into an offscreen framebuffer, with
+// no visible window (GLFW's null platform with OSMesa/EGL where available,
+// else a hidden window), and encode the frames in the background. Returns
+// the process exit code. With checkAllocations nothing is exported: the UI
+// (first scenario, if any) is drawn until it settles, then every further
+// frame must make no heap allocation on the frame thread, else it fails.
+int runHeadless(const HeadlessOptions& options);
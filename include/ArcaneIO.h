@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// Parse a decimal number ([+-]digits[.digits][e[+-]digits]) starting at p,
+// without allocating. On success stores it in value, advances p past it and
+// returns true; on failure leaves p untouched. Up to 15 significant digits
+// and exponents within +-22 take an exact fast path, longer ones use strtod.
+bool parseNumber(const char*& p, const char* end, double& value);
+
+// Write the shortest round-trip text for value into [out, end). Returns the
+// new end of the text, or nullptr if it did not fit.
+char* formatNumber(char* out, char* end, float value);
+char* formatNumber(char* out, char* end, double value);
+char* formatNumber(char* out, char* end, long double value);
+
+// Read the fields of one flat JSON object (a JSON-lines row) named in
+// names[0..count). A numeric value of names[k] goes to values[k] and sets
+// bit k of found; null, strings and unnamed keys are skipped. Returns false
+// on a malformed field: an unreadable number is skipped, while an
+// unterminated key or string, an escape cut off by the line end or a bad
+// literal ends the row there.
+bool parseJsonFields(const char* begin, const char* end, const char* const names[], int count,
+                     double values[], unsigned& found);
+
+// Hands out an input file as blocks of whole lines with bounded memory.
+// Regular files are memory-mapped where the platform allows; stdin and
+// everything else are streamed through a fixed buffer.
+class ArcaneLineReader {
+    public:
+        ArcaneLineReader() = default;
+        ~ArcaneLineReader();
+        ArcaneLineReader(const ArcaneLineReader&) = delete;
+        ArcaneLineReader& operator=(const ArcaneLineReader&) = delete;
+
+        // path == nullptr or "-" reads stdin
+        bool open(const char* path);
+        void close();
+
+        // Next run of complete lines as [begin, end); the last line of the
+        // input may lack its newline. Returns false once the input is done.
+        bool next(const char*& begin, const char*& end);
+
+        bool isMapped() const { return mapped != nullptr; }
+
+    private:
+        // memory-mapped input
+        const char* mapped = nullptr;
+        size_t mappedSize = 0;
+        size_t mappedOffset = 0;
+        int fd = -1;
+
+        // streamed input
+        FILE* file = nullptr;
+        bool ownsFile = false;
+        bool eof = false;
+        std::vector<char> buffer;
+        size_t pendingBegin = 0; // unfinished line left over from the last block
+        size_t pendingEnd = 0;
+};
+
+// Fixed-size output buffer flushed to a FILE when it fills up
+class ArcaneWriter {
+    public:
+        explicit ArcaneWriter(FILE* out, size_t capacity = 1 << 20);
+        ~ArcaneWriter();
+
+        // Make room for at least `bytes` more; flushes when needed
+        char* reserve(size_t bytes);
+        void commit(char* newEnd) { used = (size_t)(newEnd - buffer.data()); }
+        void write(const char* text, size_t length);
+        bool flush();
+        bool failed() const { return error; }
+
+    private:
+        FILE* out;
+        std::vector<char> buffer;
+        size_t used = 0;
+        bool error = false;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ArcaneTrajectory.h"
+#include <cstddef>
+
+// Air drag on the projectile, as an acceleration opposing the velocity:
+// linear a = -k v (k in 1/s), quadratic a = -k |v| v (k in 1/m)
+enum class DragModel { None, Linear, Quadratic };
+
+enum class IntegratorMethod { RK4, DormandPrince };
+
+struct IntegratorOptions {
+    DragModel drag = DragModel::None;
+    double dragCoeff = 0.0;
+    IntegratorMethod method = IntegratorMethod::DormandPrince;
+    double step = 0.01;         // RK4 step; initial step for Dormand-Prince (s)
+    double tolerance = 1e-6;    // Dormand-Prince error per step, absolute and relative
+    double minStep = 1e-6;
+    double maxStep = 0.25;
+    double maxTime = 600.0;     // give up on a flight after this long (s)
+    double groundY = 0.0;       // stop when y falls through this height
+    bool estimateRK4Error = false; // step doubling, about 3x the RK4 work
+};
+
+struct IntegratorStats {
+    size_t steps = 0;           // accepted steps
+    size_t rejected = 0;        // Dormand-Prince steps retried with a smaller h
+    size_t evaluations = 0;     // derivative evaluations
+    double maxLocalError = 0.0; // largest local error estimate of an accepted step
+    double sumLocalError = 0.0; // sum of them; a rough bound on the global error
+    bool errorEstimated = false; // false for RK4 without estimateRK4Error: the errors above are not known
+    bool landed = false;
+    double impactTime = 0.0;    // when y reached groundY, if landed
+    double impactX = 0.0;
+    double impactSpeed = 0.0;
+};
+
+// Integrate the trajectory described by params (theta in radians) under
+// gravity and drag, and fill out at t = t0 + i * dt for i in [0, count) with
+// the same columns sampleTrajectory writes. Samples after landing hold the
+// landing state. Does not allocate. Returns the number of samples taken at or
+// before landing.
+size_t integrateTrajectory(const TrajectoryParams& params, const IntegratorOptions& options,
+                           double t0, double dt, size_t count,
+                           const TrajectorySamples& out, IntegratorStats* stats = nullptr);
+
+// Integrate until landing (or options.maxTime) without sampling; the result
+// is in stats.landed / stats.impactTime
+IntegratorStats findImpact(const TrajectoryParams& params, const IntegratorOptions& options);
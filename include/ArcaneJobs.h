@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Latest-value handoff from one producer thread to one consumer thread
+// without locks. The producer fills back() and publish()es it; the consumer
+// calls update() once per frame and reads front() until the next update().
+// Neither side ever waits, and publishes the consumer never saw are dropped.
+template <typename T>
+class TripleBuffer {
+    public:
+        T& back() { return buffers[backIndex]; }
+        void publish() { backIndex = middle.exchange(backIndex | DIRTY, std::memory_order_acq_rel) & INDEX; }
+
+        // True if a newer value was published since the last call
+        bool update() {
+            if (!(middle.load(std::memory_order_relaxed) & DIRTY)) return false;
+            frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+        T& front() { return buffers[frontIndex]; }
+
+    private:
+        static const unsigned INDEX = 3;
+        static const unsigned DIRTY = 4;
+
+        T buffers[3];
+        unsigned backIndex = 0;
+        std::atomic<unsigned> middle{ 1 }; // index of the buffer between the two, plus DIRTY
+        unsigned frontIndex = 2;
+};
+
+enum class JobStatus { Queued, Running, Finished, Cancelled };
+
+// Shared by a job and its handles
+class JobControl {
+    public:
+        // Jobs poll this and return early once it is set
+        bool cancelled() const { return cancelRequested.load(std::memory_order_relaxed); }
+        // 0..1, shown by whoever holds a handle
+        void setProgress(float value) { progressValue.store(value, std::memory_order_relaxed); }
+
+    private:
+        friend class JobHandle;
+        friend class BackgroundWorker;
+
+        std::atomic<bool> cancelRequested{ false };
+        std::atomic<float> progressValue{ 0.0f };
+        std::atomic<int> status{ (int)JobStatus::Queued };
+        std::mutex mutex;
+        std::condition_variable ended;
+};
+
+// Cheap to copy; an empty handle reports Finished
+class JobHandle {
+    public:
+        JobHandle() = default;
+
+        bool valid() const { return (bool)control; }
+        JobStatus status() const;
+        bool done() const;
+        float progress() const;
+
+        // A queued job is skipped; a running one sees cancelled()
+        void cancel();
+        // Block until the job finished or was cancelled
+        void wait();
+
+    private:
+        friend class BackgroundWorker;
+        explicit JobHandle(std::shared_ptr<JobControl> control) : control(std::move(control)) {}
+
+        std::shared_ptr<JobControl> control;
+};
+
+// One thread running submitted jobs in order, so the frame loop never blocks
+// on a solve. Jobs that want more cores fan out themselves. onFinished runs
+// on the worker thread after every job, e.g. to wake a sleeping frame loop.
+class BackgroundWorker {
+    public:
+        explicit BackgroundWorker(std::function<void()> onFinished = nullptr);
+        // Cancels whatever is queued or running and joins the thread
+        ~BackgroundWorker();
+        BackgroundWorker(const BackgroundWorker&) = delete;
+        BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+        JobHandle submit(std::function<void(JobControl&)> job);
+
+    private:
+        struct Job {
+            std::shared_ptr<JobControl> control;
+            std::function<void(JobControl&)> run;
+        };
+
+        void work();
+
+        std::function<void()> onFinished;
+        std::mutex mutex;
+        std::condition_variable jobReady;
+        std::deque<Job> queue;
+        std::shared_ptr<JobControl> running;
+        bool stopping = false;
+        std::thread thread;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <imgui.h>
+
+// What the static scene depends on; any change redraws it
+struct LayerKey {
+    int width = 0, height = 0; // canvas size in framebuffer pixels
+    float scale = 0.0f;        // px per meter
+    float h0 = 0.0f;           // launch height, m
+
+    bool operator==(const LayerKey& other) const {
+        return width == other.width && height == other.height && scale == other.scale && h0 == other.h0;
+    }
+    bool operator!=(const LayerKey& other) const { return !(*this == other); }
+};
+
+// Static scene layers (sky, ground, shooter) rendered once into a texture
+// and composited as one textured quad; only the moving parts go into the
+// window's draw list each frame. The layers are drawn with the usual
+// ImDrawList calls into a private list, in canvas coordinates (origin at the
+// top-left), and rendered by the ImGui GL backend into the texture's
+// framebuffer. Needs a current GL 3.x context.
+class LayerCache {
+    public:
+        LayerCache() = default;
+        ~LayerCache();
+        LayerCache(const LayerCache&) = delete;
+        LayerCache& operator=(const LayerCache&) = delete;
+
+        // Draw list to rebuild the layers into when `key` differs from the
+        // cached one, else nullptr. Follow a non-null result with end().
+        // Also nullptr while the font atlas has no GL texture yet (the first
+        // frame on ImGui 1.92+) and after a failed end(); valid() then tells
+        // the caller to draw the layers directly.
+        ImDrawList* begin(const LayerKey& key, ImVec2 canvasSize);
+        // Render the rebuilt list into the texture; false if the framebuffer
+        // is unusable, in which case draw the layers directly instead
+        bool end();
+
+        bool valid() const { return texture != 0 && drawn; }
+        // The cached layers as one quad at `pos`, `quadSize` in window coordinates
+        void composite(ImDrawList* drawList, ImVec2 pos, ImVec2 quadSize) const;
+
+        // Frees the GL objects; call while the context is still current
+        void destroy();
+
+    private:
+        bool resize(int width, int height);
+
+        ImDrawList* list = nullptr;
+        LayerKey cached;
+        ImVec2 size = ImVec2(0, 0);
+        unsigned int fbo = 0, texture = 0;
+        int textureWidth = 0, textureHeight = 0;
+        bool drawn = false;
+        bool failed = false; // no usable framebuffer; callers draw directly
+};
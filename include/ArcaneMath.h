@@ -1,15 +1,52 @@
 #pragma once
 
+#include <cstddef>
+
+// Bits of a known-mask, one per value in the constructor ordering
+enum ArcaneKnown : unsigned char {
+    KNOWN_GRAVITY = 0x01,
+    KNOWN_YI      = 0x02,
+    KNOWN_YF      = 0x04,
+    KNOWN_VI      = 0x08,
+    KNOWN_VF      = 0x10,
+    KNOWN_D       = 0x20,
+    KNOWN_THETA   = 0x40,
+    KNOWN_TIME    = 0x80,
+    KNOWN_ALL     = 0xFF
+};
+
+// Structure-of-arrays view over many scenarios for ArcaneMath<T>::solveBatch.
+// Every column holds `count` entries and is overwritten with the solved values.
+// known[i] is an ArcaneKnown bit mask; on return it holds the mask of values
+// that are now known.
+template <typename T = float>
+struct ArcaneBatch {
+    T* gravity = nullptr;
+    T* yi = nullptr;
+    T* yf = nullptr;
+    T* vi = nullptr;
+    T* vf = nullptr;
+    T* d = nullptr;
+    T* theta = nullptr; // degrees, like the single scenario API
+    T* time = nullptr;
+    unsigned char* known = nullptr;
+    size_t count = 0;
+};
+
+// Projectile solver, generic over its scalar type. float, double and
+// long double are instantiated in ArcaneMath.cpp; use float for bulk
+// throughput and double where long flights need the extra precision.
+template <typename T = float>
 class ArcaneMath {
     private:
-        float gravity; // gravity
-        float yi; // initial y position
-        float yf; // final y position
-        float vi; // initial velocity
-        float vf; // final velocity
-        float d; // change in x position
-        float theta; // initial launch angle
-        float time; // time
+        T gravity; // gravity
+        T yi; // initial y position
+        T yf; // final y position
+        T vi; // initial velocity
+        T vf; // final velocity
+        T d; // change in x position
+        T theta; // initial launch angle
+        T time; // time
 
         bool gravityKnown;
         bool yiKnown;
@@ -19,12 +56,33 @@ class ArcaneMath {
         bool dKnown;
         bool thetaKnown;
         bool timeKnown;
+
+        int iterations; // fixed-point iterations used by the last solve()
     public:
         // Fill the provided array with the current stored values in this order:
         // [0]=gravity, [1]=yi, [2]=yf, [3]=vi, [4]=vf, [5]=d, [6]=theta, [7]=time
-        ArcaneMath(float data[8], bool known[8]);
-        void writeToArray(float data[8]);
+        ArcaneMath(T data[8], bool known[8]);
+        void writeToArray(T data[8]);
+        unsigned getKnownMask() const; // ArcaneKnown bits of the values known so far
 
         void solve();
+        int getIterations() const { return iterations; }
         void print(); // for testing purposes
+
+        // Solve every scenario in the batch in place. Gives the same results as
+        // constructing an ArcaneMath per row and calling solve(), but without the
+        // per-row object, warnings or repeated trig evaluation.
+        static void solveBatch(const ArcaneBatch<T>& batch);
+
+        // False when no assignment of values can pin down all 8 unknowns for
+        // this ArcaneKnown mask (gravity and yi are defaulted as in the constructor)
+        static bool isSolvable(unsigned knownMask);
+
+        // Print the cached solve plan for a known-mask: the equations in the
+        // order they run and which equation produces each value
+        static void printPlan(unsigned knownMask);
 };
+
+extern template class ArcaneMath<float>;
+extern template class ArcaneMath<double>;
+extern template class ArcaneMath<long double>;
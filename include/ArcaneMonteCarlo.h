@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Counter-based generator (Philox4x32-10): the output is a pure function of
+// (key, counter), so sample i draws the same numbers no matter which thread
+// runs it or in what order.
+struct Philox4x32 {
+    uint32_t key[2];
+
+    explicit Philox4x32(uint64_t seed) : key{ (uint32_t)seed, (uint32_t)(seed >> 32) } {}
+    void generate(const uint32_t counter[4], uint32_t out[4]) const;
+};
+
+// Distribution of one uncertain input
+struct InputDistribution {
+    enum Kind { Fixed, Normal, Uniform, Empirical };
+
+    Kind kind = Fixed;
+    double a = 0.0; // Fixed: value, Normal: mean, Uniform: lower bound
+    double b = 0.0; // Normal: standard deviation, Uniform: upper bound
+    std::vector<double> values; // Empirical: sorted observations
+
+    static InputDistribution fixed(double value);
+    static InputDistribution normal(double mean, double stddev);
+    static InputDistribution uniform(double lo, double hi);
+
+    // Empirical distribution from the first number on each line of a file
+    // (CSV/text; '#' lines and headers are skipped). Returns false if the file
+    // cannot be read or holds no numbers.
+    bool loadEmpirical(const char* path);
+
+    // Map two independent uniforms in (0, 1) to a draw
+    double sample(double u1, double u2) const;
+};
+
+// Fixed-memory histogram that also tracks count, mean, variance and the
+// exact min/max. Values outside [lo, hi) go to under/overflow counters, and
+// quantiles interpolate within bins (or toward min/max for those counters).
+// Histograms with the same range merge by adding counts.
+class StreamingHistogram {
+    public:
+        StreamingHistogram(double lo = 0.0, double hi = 1.0, size_t binCount = 512);
+
+        void add(double value);
+        void merge(const StreamingHistogram& other);
+
+        double quantile(double q) const;
+        uint64_t count() const { return total; }
+        double mean() const { return runningMean; }
+        double stddev() const;
+        double min() const { return minValue; }
+        double max() const { return maxValue; }
+
+        double lower() const { return lo; }
+        double upper() const { return hi; }
+        const std::vector<uint64_t>& bins() const { return counts; }
+
+    private:
+        double lo, hi, binWidth;
+        std::vector<uint64_t> counts;
+        uint64_t underflow = 0, overflow = 0, total = 0;
+        double runningMean = 0.0, m2 = 0.0;
+        double minValue, maxValue;
+};
+
+struct MonteCarloConfig {
+    InputDistribution vi = InputDistribution::fixed(20.0);    // m/s
+    InputDistribution theta = InputDistribution::fixed(45.0); // degrees
+    InputDistribution h0 = InputDistribution::fixed(0.0);     // launch height (m)
+    InputDistribution gravity = InputDistribution::fixed(9.8);
+
+    size_t samples = 1000000;
+    uint64_t seed = 1;
+    unsigned threads = 0;        // 0 = the shared TaskScheduler
+    size_t histogramBins = 512;
+    size_t bandStations = 64;    // x positions of the path band
+    double bandQuantiles[3] = { 0.05, 0.5, 0.95 };
+
+    // Called from the worker threads after every chunk with the samples done
+    // so far; returning false stops the run early
+    std::function<bool(size_t done, size_t total)> onProgress;
+};
+
+// Landing distance and flight time of every sample that lands on y = 0, and
+// quantiles of the height across samples at evenly spaced x stations
+// (samples that already landed count as y = 0).
+struct MonteCarloResult {
+    StreamingHistogram distance;
+    StreamingHistogram time;
+    size_t samples = 0;  // drawn; fewer than requested if cancelled
+    size_t unsolved = 0; // samples the solver could not land
+    bool cancelled = false;
+    double seconds = 0.0;
+
+    std::vector<float> bandX;
+    std::vector<float> bandLow;  // bandQuantiles[0]
+    std::vector<float> bandMid;  // bandQuantiles[1]
+    std::vector<float> bandHigh; // bandQuantiles[2]
+};
+
+// Draw config.samples scenarios, land each one with ArcaneMath<double>::solveBatch
+// on all threads and accumulate the results without keeping the samples
+MonteCarloResult runMonteCarlo(const MonteCarloConfig& config);
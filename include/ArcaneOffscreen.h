@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size framebuffer to render into without a visible window. Readback
+// goes through two pixel-pack buffers: capture() starts the transfer of the
+// frame just drawn and then copies out the one started a frame earlier,
+// which has had a whole frame to finish, so glReadPixels never stalls.
+class OffscreenTarget {
+    public:
+        OffscreenTarget() = default;
+        ~OffscreenTarget();
+        OffscreenTarget(const OffscreenTarget&) = delete;
+        OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+        // Needs a current GL 3.x context; false if the framebuffer is incomplete
+        bool create(int width, int height);
+        void destroy();
+
+        // Render into the target (sets the viewport) / back to the window
+        void bind();
+        void unbind();
+
+        // Queue the readback of the current contents under `tag`. If the
+        // previous capture is ready to copy, it is written to out (bottom-up
+        // RGBA rows) with its tag and true is returned.
+        bool capture(int tag, std::vector<uint8_t>& out, int& outTag);
+        // Copy out the last pending capture, if any
+        bool drain(std::vector<uint8_t>& out, int& outTag);
+
+        int width() const { return w; }
+        int height() const { return h; }
+
+    private:
+        bool copyOut(int buffer, std::vector<uint8_t>& out, int& outTag);
+
+        int w = 0, h = 0;
+        GLuint fbo = 0, color = 0;
+        GLuint pbo[2] = { 0, 0 };
+        bool pending[2] = { false, false };
+        int tags[2] = { 0, 0 };
+        int next = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class Decimation { None, MinMax, LTTB };
+
+// Points to hand to the plotting call. Valid until the next assign() or view()
+// on the series it came from.
+struct PlotView {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    int count = 0;
+};
+
+// Arbitrary-length (x, y) series that decimates to the plot's pixel width.
+// MinMax keeps the lowest and highest point of every bucket, so spikes survive,
+// and reads a pyramid of per-block extremes built once in assign(): its cost
+// follows the pixel width, not the series length. LTTB scans the visible
+// points. The last few views are cached, so an unchanged zoom costs nothing.
+class PlotSeries {
+    public:
+        void assign(const float* x, const float* y, size_t count);
+        void clear();
+
+        size_t size() const { return xs.size(); }
+        bool sorted() const { return xSorted; }
+
+        // Extent of all points, for fitting axis limits without a scan
+        float xMin() const { return xLo; }
+        float xMax() const { return xHi; }
+        float yMin() const { return yLo; }
+        float yMax() const { return yHi; }
+
+        // Points to draw for the visible x range [viewMin, viewMax] at `pixels`
+        // width. Series whose x is not non-decreasing are decimated as a whole.
+        PlotView view(double viewMin, double viewMax, int pixels, Decimation mode);
+
+    private:
+        struct Extremes { uint32_t lo, hi; }; // indices of the min and max y of a block
+
+        struct CachedView {
+            double viewMin = 0.0, viewMax = 0.0;
+            int pixels = 0;
+            Decimation mode = Decimation::None;
+            uint64_t lastUsed = 0; // 0 = empty slot
+            std::vector<uint32_t> picked;
+            std::vector<float> x, y;
+        };
+
+        void buildPyramid();
+        void visibleRange(double viewMin, double viewMax, size_t& first, size_t& last) const;
+        void pickMinMax(size_t first, size_t last, int pixels, std::vector<uint32_t>& picked) const;
+        void pickLTTB(size_t first, size_t last, int pixels, std::vector<uint32_t>& picked) const;
+
+        std::vector<float> xs, ys;
+        bool xSorted = true;
+        float xLo = 0.0f, xHi = 0.0f, yLo = 0.0f, yHi = 0.0f;
+
+        std::vector<std::vector<Extremes>> levels; // levels[k]: blocks of 2^(k + 1) points
+        CachedView cache[4];
+        uint64_t useCounter = 0;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ArcaneAllocations.h"
+
+// Scoped CPU timers for the frame loop and worker threads. Every thread
+// records into its own ring that only it writes and only the frame thread
+// reads, so a scope costs two clock reads and no lock. Without
+// ARCANE_ENABLE_PROFILING the macros compile to nothing.
+#ifdef ARCANE_ENABLE_PROFILING
+    #define ARCANE_PROFILE_CONCAT_(a, b) a##b
+    #define ARCANE_PROFILE_CONCAT(a, b) ARCANE_PROFILE_CONCAT_(a, b)
+    #define ARCANE_PROFILE_SCOPE(name) ProfileScope ARCANE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+    #define ARCANE_PROFILE_FRAME() Profiler::instance().endFrame()
+#else
+    #define ARCANE_PROFILE_SCOPE(name) ((void)0)
+    #define ARCANE_PROFILE_FRAME() ((void)0)
+#endif
+
+struct ProfileEvent {
+    const char* name;    // string literal
+    uint64_t start, end; // ns since the profiler started
+    uint32_t thread;     // 0 = the first thread that recorded (the frame thread)
+    uint32_t depth;      // nesting on its thread
+    uint32_t allocations; // heap allocations inside the scope (ARCANE_TRACK_ALLOCATIONS)
+    uint64_t bytes;
+};
+
+struct ProfileFrame {
+    uint64_t start = 0, end = 0;
+    AllocationCount allocations; // made on the frame thread during the frame
+    std::vector<ProfileEvent> events;
+};
+
+// Per-frame time of one scope (ms, summed within a frame) over the frames it ran in
+struct ProfileScopeStats {
+    const char* name;
+    size_t frames;
+    double mean, p50, p95, p99, max;
+    double allocations; // mean heap allocations per frame it ran in
+};
+
+class Profiler {
+    public:
+        static const size_t HISTORY_FRAMES = 240;
+        static const size_t RING_EVENTS = 4096;
+
+        static Profiler& instance();
+
+        uint64_t now() const;
+        // Scope nesting on the calling thread; record() tags events with it
+        void enter();
+        void leave();
+        // Lock-free; events past a full ring are counted as dropped
+        void record(const char* name, uint64_t start, uint64_t end,
+                    uint64_t allocations = 0, uint64_t bytes = 0);
+
+        // Close the current frame and drain every thread's ring into it
+        void endFrame();
+
+        // Frame i of the kept history, 0 = oldest
+        size_t frameCount() const { return stored; }
+        const ProfileFrame& frame(size_t i) const;
+        std::vector<ProfileScopeStats> scopeStats() const;
+        uint64_t droppedEvents() const { return dropped.load(std::memory_order_relaxed); }
+
+        // While paused frames are drained but not kept, freezing the history
+        void setPaused(bool value) { paused = value; }
+        bool isPaused() const { return paused; }
+
+    private:
+        struct ThreadRing;
+        struct RingHandle;
+
+        Profiler();
+        ThreadRing& ring();
+
+        const uint64_t epoch;
+        std::mutex registry; // guards rings; taken once per thread and in endFrame
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+        std::atomic<uint64_t> dropped{ 0 };
+
+        std::vector<ProfileFrame> history;
+        ProfileFrame discarded; // drain target while paused
+        size_t next = 0, stored = 0;
+        uint64_t lastFrameEnd = 0;
+        AllocationCount lastFrameAllocations;
+        bool paused = false;
+};
+
+#ifdef ARCANE_ENABLE_PROFILING
+class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name)
+            : name(name), startAllocations(threadAllocations()), start(Profiler::instance().now()) {
+            Profiler::instance().enter();
+        }
+        ~ProfileScope() {
+            Profiler& profiler = Profiler::instance();
+            uint64_t end = profiler.now();
+            AllocationCount allocations = threadAllocations();
+            profiler.leave();
+            profiler.record(name, start, end, allocations.count - startAllocations.count,
+                            allocations.bytes - startAllocations.bytes);
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* name;
+        AllocationCount startAllocations;
+        uint64_t start;
+};
+#endif
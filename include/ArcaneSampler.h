@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ArcaneIntegrator.h"
+#include "ArcaneTrajectory.h"
+#include <cstddef>
+#include <vector>
+
+// A solved launch to sample: the vacuum parabola, or the integrated path
+// when drag is on. Sampling runs until landing on y = 0 or maxTime.
+struct TrajectorySource {
+    TrajectoryParams params;      // theta in radians
+    bool drag = false;
+    IntegratorOptions integrator; // used when drag is true
+    float maxTime = 8.0f;
+};
+
+struct SamplePolicy {
+    enum Kind { UniformTime, UniformArcLength, PixelError };
+
+    Kind kind = UniformTime;
+    size_t count = 100;          // samples for the uniform kinds
+    float pxPerMeter = 20.0f;    // PixelError: current view scale
+    float maxPixelError = 0.5f;  // PixelError: allowed chord deviation (px)
+    size_t maxSamples = 4096;    // PixelError: upper bound on the output
+};
+
+// Caller-owned sample columns. Storage only ever grows, so re-sampling into
+// the same buffers stops allocating once they have seen the largest count.
+struct TrajectoryBuffers {
+    std::vector<float> t, x, y, vx, vy, speed;
+    size_t count = 0;
+    float endTime = 0.0f; // last sampled time
+    bool landed = false;  // the path ends on the ground rather than at maxTime
+
+    // Position at time t along the sampled path, linear between samples and
+    // held at the ends; used to animate along exactly what is plotted
+    void positionAt(float time, float& outX, float& outY) const;
+    TrajectorySamples columns();
+    void reserve(size_t samples);
+};
+
+// One sampling pass per solve, shared by plots, animation and export.
+// Keeps a dense scratch grid for the non-uniform policies, so a sampler kept
+// alive across solves is allocation-free after warm-up as well.
+class TrajectorySampler {
+    public:
+        void sample(const TrajectorySource& source, const SamplePolicy& policy, TrajectoryBuffers& out);
+
+        // Landing search of the last drag sample() (empty for vacuum paths)
+        const IntegratorStats& integratorStats() const { return lastStats; }
+
+    private:
+        float landingTime(const TrajectorySource& source, bool& landed);
+        void evaluate(const TrajectorySource& source, float endTime, size_t count, TrajectoryBuffers& out);
+
+        TrajectoryBuffers dense;
+        IntegratorStats lastStats;
+        std::vector<double> arcLength;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskScheduler;
+
+// Tasks spawned together that can be waited on and cancelled together.
+// Cancelling skips the group's tasks that have not started; running ones
+// can poll cancelled() and return early. Destruction waits.
+class TaskGroup {
+    public:
+        explicit TaskGroup(TaskScheduler& scheduler);
+        TaskGroup();
+        ~TaskGroup();
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(std::function<void()> task);
+
+        // A worker of the scheduler runs other tasks while it waits; any
+        // other thread sleeps
+        void wait();
+        // As wait(), for at most `seconds`; true once every task finished
+        bool waitFor(double seconds);
+
+        void cancel() { cancelRequested.store(true, std::memory_order_relaxed); }
+        bool cancelled() const { return cancelRequested.load(std::memory_order_relaxed); }
+
+        TaskScheduler& scheduler() const { return owner; }
+
+    private:
+        friend class TaskScheduler;
+        void finishOne();
+
+        TaskScheduler& owner;
+        std::atomic<size_t> pending{ 0 };
+        std::atomic<bool> cancelRequested{ false };
+        std::mutex mutex;
+        std::condition_variable finished;
+};
+
+struct SchedulerOptions {
+    unsigned threads = 0;    // workers; 0 = one per hardware thread
+    bool pinThreads = false; // worker i on core i (Linux only, ignored elsewhere)
+};
+
+// Work-stealing pool: every worker runs tasks from its own deque, newest
+// first, and when that runs dry steals the oldest task of a random other
+// worker. Threads outside the pool hand tasks in through a shared queue.
+// Idle workers sleep instead of spinning.
+class TaskScheduler {
+    public:
+        explicit TaskScheduler(const SchedulerOptions& options = SchedulerOptions());
+        ~TaskScheduler();
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        // Process-wide pool, created on first use
+        static TaskScheduler& shared();
+        // Options for shared(); false once it already exists
+        static bool configureShared(const SchedulerOptions& options);
+        // shared(), or a private pool in `own` when a specific thread count
+        // is asked for that shared() does not have
+        static TaskScheduler& select(unsigned threads, std::unique_ptr<TaskScheduler>& own);
+
+        unsigned workerCount() const { return (unsigned)workers.size(); }
+        // Index of the calling worker, or workerCount() on any other thread
+        unsigned currentWorker() const;
+
+        // Calls body(first, last) over disjoint pieces of [begin, end) on the
+        // workers. Pieces start at the whole range and are split in half only
+        // while the worker holding one has nothing queued for thieves, so
+        // splitting follows demand; grain is the smallest piece (0 = chosen
+        // from the range and worker count). The blocking form waits; the
+        // other adds to `group` and returns, and stops once it is cancelled.
+        void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain = 0);
+        void parallelFor(TaskGroup& group, size_t begin, size_t end,
+                         std::function<void(size_t, size_t)> body, size_t grain = 0);
+
+    private:
+        friend class TaskGroup;
+        struct Task;
+        struct Worker;
+        struct Range;
+
+        void spawn(Task* task);
+        Task* findTask(unsigned self);
+        void execute(Task* task);
+        void workerLoop(unsigned index);
+        void splitRange(const std::shared_ptr<Range>& range, size_t first, size_t last);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        std::mutex mutex;               // guards injected; sleeping workers wait on it
+        std::condition_variable wakeUp;
+        std::deque<Task*> injected;     // tasks spawned from outside the pool
+        std::atomic<size_t> available{ 0 }; // tasks queued anywhere and not yet taken
+        std::atomic<unsigned> sleepers{ 0 };
+        bool stopping = false;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "ArcaneMath.h"
+#include <cmath>
+
+// Solver internals shared by ArcaneMath::solve and ArcaneMath::solveBatch.
+// Everything here works on radians; degree conversion stays in ArcaneMath.
+
+// Threshold for divisors and roots at each precision. float keeps the
+// original 1e-6; the wider types use a bound that matches their epsilon.
+template <typename T> constexpr T SOLVE_EPS = T(1e-6);
+template <> constexpr double SOLVE_EPS<double> = 1e-12;
+template <> constexpr long double SOLVE_EPS<long double> = 1e-15L;
+
+// Working copy of one scenario
+template <typename T>
+struct SolveState {
+    T gravity, yi, yf, vi, vf, d, theta, time;
+    bool gravityKnown, yiKnown, yfKnown, viKnown, vfKnown, dKnown, thetaKnown, timeKnown;
+
+    // sin/cos of theta, refreshed whenever theta becomes known
+    T sinTheta, cosTheta;
+
+    void cacheTrig() {
+        sinTheta = std::sin(theta);
+        cosTheta = std::cos(theta);
+    }
+
+    unsigned knownMask() const {
+        unsigned mask = 0;
+        if (gravityKnown) mask |= KNOWN_GRAVITY;
+        if (yiKnown)      mask |= KNOWN_YI;
+        if (yfKnown)      mask |= KNOWN_YF;
+        if (viKnown)      mask |= KNOWN_VI;
+        if (vfKnown)      mask |= KNOWN_VF;
+        if (dKnown)       mask |= KNOWN_D;
+        if (thetaKnown)   mask |= KNOWN_THETA;
+        if (timeKnown)    mask |= KNOWN_TIME;
+        return mask;
+    }
+};
+
+// The equations of the solver in the order solveState tries them
+enum SolveRule : unsigned char {
+    RULE_TIME_FROM_HORIZONTAL,
+    RULE_D_FROM_HORIZONTAL,
+    RULE_VI_FROM_HORIZONTAL,
+    RULE_THETA_FROM_HORIZONTAL,
+    RULE_ASSUME_YI,
+    RULE_YF_FROM_VERTICAL,
+    RULE_LANDING,
+    RULE_YI_FROM_VERTICAL,
+    RULE_VI_FROM_VERTICAL,
+    RULE_THETA_FROM_VERTICAL,
+    RULE_TIME_FROM_VERTICAL,
+    RULE_TIME_FROM_LANDING,
+    RULE_VF_FROM_COMPONENTS,
+    RULE_COUNT
+};
+
+// The equation graph: each equation consumes its `inputs` variables and
+// produces its `outputs`, and only fires while none of its `excludes` bits are
+// known (ArcaneKnown masks). Listing order is the priority solveState uses.
+struct SolveEquation {
+    unsigned char inputs;
+    unsigned char excludes;
+    unsigned char outputs;
+    const char* name;
+};
+
+constexpr unsigned char VERTICAL_INPUTS = KNOWN_GRAVITY | KNOWN_THETA;
+
+constexpr SolveEquation SOLVE_EQUATIONS[RULE_COUNT] = {
+    { KNOWN_D | KNOWN_VI | KNOWN_THETA, KNOWN_TIME, KNOWN_TIME,
+      "time = d / (vi cos(theta))" },
+    { KNOWN_VI | KNOWN_THETA | KNOWN_TIME, KNOWN_D, KNOWN_D,
+      "d = vi cos(theta) t" },
+    { KNOWN_D | KNOWN_THETA | KNOWN_TIME, KNOWN_VI, KNOWN_VI,
+      "vi = d / (cos(theta) t)" },
+    { KNOWN_D | KNOWN_VI | KNOWN_TIME, KNOWN_THETA, KNOWN_THETA,
+      "theta = acos(d / (vi t))" },
+    { KNOWN_VI | KNOWN_TIME | VERTICAL_INPUTS, KNOWN_YI | KNOWN_YF, KNOWN_YI,
+      "yi = 0 (launch from ground)" },
+    { KNOWN_YI | KNOWN_VI | KNOWN_TIME | VERTICAL_INPUTS, KNOWN_YF, KNOWN_YF,
+      "yf = yi + vi sin(theta) t - g t^2 / 2" },
+    { KNOWN_YF | KNOWN_D, 0, 0,
+      "landing clamp: yf = 0 once at or below ground" },
+    { KNOWN_YF | KNOWN_VI | KNOWN_TIME | VERTICAL_INPUTS, KNOWN_YI, KNOWN_YI,
+      "yi = yf - vi sin(theta) t + g t^2 / 2" },
+    { KNOWN_YI | KNOWN_YF | KNOWN_TIME | VERTICAL_INPUTS, KNOWN_VI, KNOWN_VI,
+      "vi = (yf - yi + g t^2 / 2) / (sin(theta) t)" },
+    { KNOWN_YI | KNOWN_YF | KNOWN_VI | KNOWN_TIME | KNOWN_GRAVITY, KNOWN_THETA, KNOWN_THETA,
+      "theta = asin((yf - yi + g t^2 / 2) / (vi t))" },
+    { KNOWN_YI | KNOWN_YF | KNOWN_VI | VERTICAL_INPUTS, KNOWN_TIME, KNOWN_TIME,
+      "time from yf = yi + vi sin(theta) t - g t^2 / 2" },
+    { KNOWN_YI | KNOWN_VI | VERTICAL_INPUTS, KNOWN_TIME | KNOWN_YF, KNOWN_TIME,
+      "time to land (yf = 0)" },
+    { KNOWN_VI | KNOWN_TIME | VERTICAL_INPUTS, KNOWN_VF, KNOWN_VF,
+      "vf = |(vi cos(theta), vi sin(theta) - g t)|" },
+};
+
+struct SolveStep {
+    unsigned char rule;
+    unsigned char iteration; // fixed-point iteration the rule fires in (1-based)
+    bool terminal;           // landing only: stops the solve when it triggers
+};
+
+// producer[] entries that are not a SolveRule
+constexpr unsigned char PRODUCER_INPUT = 0xFE;   // known before solving
+constexpr unsigned char PRODUCER_UNSOLVED = 0xFF;
+
+// The sequence of equations the fixed-point loop applies for one known-mask,
+// assuming every runtime guard (non-zero divisor, real root ...) passes.
+struct SolvePlan {
+    SolveStep steps[32];
+    int count;
+    int iterations;          // loop iterations solveState would report
+    unsigned char solvedMask;
+    unsigned char producer[8]; // per value (ArcaneKnown bit order): rule or PRODUCER_*
+};
+
+// Topological schedule of the equation graph for one known-mask. Each round
+// fires every equation whose inputs are ready, in SOLVE_EQUATIONS priority
+// order, which is exactly the order solveState's loop discovers by trial.
+// Flags only, so it runs at compile time.
+constexpr SolvePlan buildSolvePlan(unsigned mask) {
+    SolvePlan plan = {};
+    unsigned known = mask & 0xFF;
+    for (int v = 0; v < 8; ++v) {
+        plan.producer[v] = (known & (1u << v)) ? PRODUCER_INPUT : PRODUCER_UNSOLVED;
+    }
+
+    int iteration = 0;
+    bool updated = true;
+    while (updated && iteration < 100) {
+        updated = false;
+        ++iteration;
+        int landingStep = -1;
+        for (int r = 0; r < RULE_COUNT; ++r) {
+            const SolveEquation& eq = SOLVE_EQUATIONS[r];
+            if ((known & eq.inputs) != eq.inputs || (known & eq.excludes) != 0) continue;
+            if (r == RULE_LANDING) landingStep = plan.count;
+            else updated = true;
+            for (int v = 0; v < 8; ++v) {
+                if (eq.outputs & (1u << v)) plan.producer[v] = (unsigned char)r;
+            }
+            known |= eq.outputs;
+            plan.steps[plan.count++] = { (unsigned char)r, (unsigned char)iteration, false };
+        }
+        // A landing clamp only ends the solve when nothing fires after it
+        if (landingStep >= 0) plan.steps[landingStep].terminal = (landingStep == plan.count - 1);
+    }
+    plan.iterations = iteration;
+    plan.solvedMask = (unsigned char)known;
+    return plan;
+}
+
+// The plan for a mask, built once at compile time for all 256 masks
+const SolvePlan& solvePlan(unsigned mask);
+
+// Generic fixed-point solve; returns the number of iterations used.
+// Instantiated for float, double and long double.
+template <typename T>
+int solveState(SolveState<T>& s);
+
+// Solve with the solver specialized for the state's known-mask. Falls back to
+// solveState when a runtime guard fails so results always match it exactly.
+template <typename T>
+int solveSpecialized(SolveState<T>& s);
+
+// Whether the plan for this exact mask ends with every value known
+bool isMaskSolvable(unsigned mask);
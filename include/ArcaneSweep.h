@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// One axis of a sweep grid: `steps` evenly spaced values from min to max
+// (just min when steps == 1)
+struct SweepAxis {
+    float min = 0.0f;
+    float max = 0.0f;
+    size_t steps = 1;
+
+    float at(size_t i) const {
+        return steps > 1 ? min + (max - min) * (float)i / (float)(steps - 1) : min;
+    }
+};
+
+// Launch grid; theta in degrees like ArcaneMath. Every point lands on y = 0.
+struct SweepSpec {
+    SweepAxis theta;
+    SweepAxis vi;
+    SweepAxis h0;
+    SweepAxis g;
+
+    size_t count() const { return theta.steps * vi.steps * h0.steps * g.steps; }
+
+    // Position of a grid point in the dense outputs; theta varies fastest
+    size_t index(size_t it, size_t iv, size_t ih, size_t ig) const {
+        return ((ig * h0.steps + ih) * vi.steps + iv) * theta.steps + it;
+    }
+};
+
+// Dense per-point outputs, laid out by SweepSpec::index. Points that never
+// come back down to y = 0 hold NaN.
+struct SweepResults {
+    std::vector<float> range;       // horizontal distance at landing (m)
+    std::vector<float> apex;        // highest y reached (m)
+    std::vector<float> flightTime;  // time until landing (s)
+    std::vector<float> impactSpeed; // speed at landing (m/s)
+};
+
+struct SweepOptions {
+    unsigned threads = 0;              // 0 = the shared TaskScheduler
+    size_t tileSize = 16384;           // grid points per work item
+    const char* checkpointPath = nullptr;
+    double checkpointInterval = 5.0;   // seconds between checkpoint writes
+};
+
+// Splits the grid into tiles of consecutive points and runs them as a
+// TaskScheduler parallelFor. With a checkpoint path, finished tiles are written out as they
+// complete, and a later run with the same spec and tile size only computes
+// the tiles still missing.
+class ArcaneSweep {
+    public:
+        explicit ArcaneSweep(const SweepSpec& spec) : spec(spec) {}
+
+        // Fills results (resized to spec.count()). Returns false if cancelled
+        // or the checkpoint could not be written; finished tiles are kept.
+        bool run(SweepResults& results, const SweepOptions& options = SweepOptions());
+
+        // Safe to call from any thread while run() is in progress
+        void cancel() { cancelled = true; }
+        size_t completedPoints() const { return completed; }
+        size_t totalPoints() const { return spec.count(); }
+
+    private:
+        void computeTile(size_t begin, size_t end, SweepResults& results,
+                         const std::vector<double>& sinTheta, const std::vector<double>& cosTheta) const;
+
+        SweepSpec spec;
+        std::atomic<bool> cancelled{false};
+        std::atomic<size_t> completed{0};
+};
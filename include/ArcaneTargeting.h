@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+// Inverse targeting: which launch angles hit (d, yf) from (0, yi) at speed vi.
+// Angles are in degrees like ArcaneMath; a target straight above or below the
+// launch point (d == 0) is reached at +-90 degrees. d is taken as a distance,
+// so a negative d gives the same answers as |d|.
+
+template <typename T = float>
+struct TargetArc {
+    T theta; // launch angle (degrees)
+    T time;  // time until the target is reached (s)
+};
+
+template <typename T = float>
+struct TargetSolution {
+    int count = 0;      // valid entries in arcs: 0, 1 (grazing shot) or 2
+    TargetArc<T> arcs[2]; // low arc first, then high arc
+
+    // Slowest launch that reaches the target at all, and its angle and time.
+    // NaN when gravity is not positive.
+    T minSpeed;
+    T minSpeedTheta;
+    T minSpeedTime;
+};
+
+// Every (theta, time) pair that reaches the target at speed vi, plus the
+// minimum-speed solution
+template <typename T>
+TargetSolution<T> solveTarget(T gravity, T yi, T yf, T vi, T d);
+
+// Structure-of-arrays form of solveTarget for aiming tables. Inputs and
+// outputs hold `count` entries; a missing arc is written as NaN, and
+// arcCount (optional) receives how many arcs each target has.
+template <typename T = float>
+struct TargetBatch {
+    const T* gravity = nullptr;
+    const T* yi = nullptr;
+    const T* yf = nullptr;
+    const T* vi = nullptr;
+    const T* d = nullptr;
+
+    T* lowTheta = nullptr;
+    T* lowTime = nullptr;
+    T* highTheta = nullptr;
+    T* highTime = nullptr;
+    T* minSpeed = nullptr;      // optional
+    T* minSpeedTheta = nullptr; // optional
+    unsigned char* arcCount = nullptr; // optional
+    size_t count = 0;
+};
+
+template <typename T>
+void solveTargets(const TargetBatch<T>& batch);
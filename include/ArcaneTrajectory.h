@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+// Launch parameters of a vacuum projectile; theta in radians
+struct TrajectoryParams {
+    float v0 = 0.0f;     // launch speed (m/s)
+    float theta = 0.0f;  // launch angle (rad)
+    float h0 = 0.0f;     // launch height (m)
+    float g = 9.8f;      // gravity (m/s^2)
+};
+
+// Caller-owned output columns. Any pointer may be null to skip that output;
+// non-null ones must hold at least `count` floats.
+struct TrajectorySamples {
+    float* t = nullptr;
+    float* x = nullptr;
+    float* y = nullptr;
+    float* vx = nullptr;
+    float* vy = nullptr;
+    float* speed = nullptr;
+};
+
+// Evaluate x = v0 cos(theta) t, y = h0 + v0 sin(theta) t - g t^2 / 2 and the
+// velocity at t = t0 + i * dt for i in [0, count). y is clamped to at least
+// yFloor. Runs 8 lanes at a time with AVX2, 4 with SSE, or scalar, picked
+// once from the CPU at first use.
+void sampleTrajectory(const TrajectoryParams& params, float t0, float dt, size_t count,
+                      const TrajectorySamples& out,
+                      float yFloor = std::numeric_limits<float>::lowest());
+
+// Name of the kernel sampleTrajectory dispatches to ("avx2", "sse" or "scalar")
+const char* trajectoryKernelName();
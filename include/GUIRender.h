@@ -3,14 +3,55 @@
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include "ArcaneJobs.h"
+#include "ArcaneLayers.h"
 
 class GUIRender {
     public:
         void Init(GLFWwindow* window, const char* glsl_version);
+        // Block until there is something to draw (input, a running animation or
+        // a Wake()), or just poll when render-on-demand is off
+        void WaitForEvents();
         void NewFrame();
         virtual void Update(GLFWwindow* window);
         void Render();
         void Shutdown();
+
+        // Thread-safe: redraw soon, e.g. when a background job finishes
+        void Wake();
+
+        // Show this launch on the next Update as if it had just been solved
+        // (theta in degrees); used by headless export
+        void SetScenario(float v0, float thetaDeg, float h0, float g);
+
     private:
+        void RequestRedraw(int frames);
+
         ImFont* customFont = nullptr;
-};
\ No newline at end of file
+        std::unique_ptr<BackgroundWorker> pathJobs; // path sampling
+        std::unique_ptr<BackgroundWorker> mcJobs;   // Monte Carlo, so a long run never delays a path
+        LayerCache sceneLayers; // sky, ground and shooter of the simulation canvas
+
+        struct Scenario { float v0, thetaDeg, h0, g; };
+        Scenario scenario = { 0.0f, 0.0f, 0.0f, 0.0f };
+        bool hasScenario = false;
+        // Set by SetScenario: every path job is waited for in the frame that
+        // queued it, so exported frames never depend on worker timing
+        bool waitForPaths = false;
+
+        bool renderOnDemand = true;
+        int redrawFrames = 0;
+        std::atomic<bool> wakeRequested{ false };
+
+        // Idle metrics, refreshed about once a second
+        double statsStart = 0.0;
+        double statsWaitSeconds = 0.0;
+        int statsFrames = 0;
+        std::clock_t statsCpuStart = 0;
+        float framesPerSecond = 0.0f;
+        float idlePercent = 0.0f;
+        float cpuPercent = 0.0f;
+};
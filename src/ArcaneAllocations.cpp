@@ -0,0 +1,77 @@
+#include "../include/ArcaneAllocations.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Plain zero-initialized thread-locals: safe to touch from operator new at
+// any point of a thread's life, including before main and during exit
+thread_local uint64_t allocationCount = 0;
+thread_local uint64_t allocationBytes = 0;
+
+inline void count(size_t size) {
+#ifdef ARCANE_TRACK_ALLOCATIONS
+    allocationCount++;
+    allocationBytes += size;
+#else
+    (void)size;
+#endif
+}
+
+} // namespace
+
+bool allocationTrackingEnabled() {
+#ifdef ARCANE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCount threadAllocations() {
+    AllocationCount totals;
+    totals.count = allocationCount;
+    totals.bytes = allocationBytes;
+    return totals;
+}
+
+void* countedAlloc(size_t size, void* user) {
+    (void)user;
+    count(size);
+    return std::malloc(size);
+}
+
+void countedFree(void* ptr, void* user) {
+    (void)user;
+    std::free(ptr);
+}
+
+#ifdef ARCANE_TRACK_ALLOCATIONS
+// Replaceable global allocation functions. The over-aligned forms are left
+// to the library; nothing in the project allocates over-aligned types.
+void* operator new(size_t size) {
+    count(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+#endif
@@ -0,0 +1,186 @@
+#include "../include/ArcaneArena.h"
+#include "../include/ArcaneAllocations.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <new>
+
+namespace {
+
+// Block headers are padded so what follows keeps malloc's alignment
+const size_t ARENA_HEADER = 2 * alignof(std::max_align_t);
+// Pool chunks start with their size class; 16 bytes keeps the payload
+// aligned like malloc's on 64-bit targets
+const size_t CHUNK_HEADER = 16;
+const size_t SMALLEST_CHUNK = 32;
+const uint32_t LARGE_CHUNK = 0xFFFFFFFFu; // class tag of malloc'd requests
+
+size_t alignUp(size_t value, size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+} // namespace
+
+const size_t FrameArena::BLOCK_BYTES;
+const size_t PoolAllocator::SLAB_BYTES;
+const size_t PoolAllocator::SIZE_CLASSES;
+
+// ---------------------------------------------------------------------------
+// FrameArena
+// ---------------------------------------------------------------------------
+
+FrameArena& FrameArena::instance() {
+    static FrameArena arena;
+    return arena;
+}
+
+FrameArena::~FrameArena() {
+    while (current) {
+        Block* previous = current->previous;
+        countedFree(current, nullptr);
+        current = previous;
+    }
+}
+
+uint8_t* FrameArena::base(Block* block) {
+    return reinterpret_cast<uint8_t*>(block) + ARENA_HEADER;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t align) {
+    if (current) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(base(current));
+        size_t at = alignUp(start + offset, align) - start;
+        if (at + bytes <= current->size) {
+            offset = at + bytes;
+            peak = std::max(peak, used());
+            return base(current) + at;
+        }
+    }
+    grow(bytes, align);
+    // Fresh blocks are aligned for max_align_t; larger alignments pad
+    uintptr_t start = reinterpret_cast<uintptr_t>(base(current));
+    size_t at = alignUp(start, align) - start;
+    offset = at + bytes;
+    peak = std::max(peak, used());
+    return base(current) + at;
+}
+
+void FrameArena::grow(size_t bytes, size_t align) {
+    size_t size = std::max(BLOCK_BYTES, bytes + align);
+    Block* block = static_cast<Block*>(countedAlloc(ARENA_HEADER + size, nullptr));
+    if (!block) throw std::bad_alloc();
+    block->previous = current;
+    block->size = size;
+    if (current) usedBefore += offset;
+    current = block;
+    offset = 0;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    int length = std::vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+    char* text = static_cast<char*>(allocate((size_t)length + 1, 1));
+    std::vsnprintf(text, (size_t)length + 1, fmt, args);
+    va_end(args);
+    return text;
+}
+
+void FrameArena::reset() {
+    if (current && current->previous) {
+        // Last frame needed a chain: replace it with one block that fits it
+        // (with slack for alignment padding landing differently)
+        while (current) {
+            Block* previous = current->previous;
+            countedFree(current, nullptr);
+            current = previous;
+        }
+        grow(alignUp(peak + peak / 16, BLOCK_BYTES), 1);
+    }
+    offset = 0;
+    usedBefore = 0;
+}
+
+// ---------------------------------------------------------------------------
+// PoolAllocator
+// ---------------------------------------------------------------------------
+
+PoolAllocator& PoolAllocator::ui() {
+    static PoolAllocator pool;
+    return pool;
+}
+
+PoolAllocator::~PoolAllocator() {
+    while (slabs) {
+        void* next = *static_cast<void**>(slabs);
+        countedFree(slabs, nullptr);
+        slabs = next;
+    }
+}
+
+void* PoolAllocator::allocate(size_t bytes) {
+    const size_t need = bytes + CHUNK_HEADER;
+    size_t sizeClass = 0;
+    while (sizeClass < SIZE_CLASSES && (SMALLEST_CHUNK << sizeClass) < need) sizeClass++;
+
+    uint8_t* chunk;
+    if (sizeClass == SIZE_CLASSES) {
+        chunk = static_cast<uint8_t*>(countedAlloc(need, nullptr));
+        if (!chunk) return nullptr;
+        *reinterpret_cast<uint32_t*>(chunk) = LARGE_CHUNK;
+    } else {
+        if (!freeLists[sizeClass]) refill(sizeClass);
+        if (!freeLists[sizeClass]) return nullptr;
+        FreeBlock* block = freeLists[sizeClass];
+        freeLists[sizeClass] = block->next;
+        chunk = reinterpret_cast<uint8_t*>(block);
+        *reinterpret_cast<uint32_t*>(chunk) = (uint32_t)sizeClass;
+    }
+    live++;
+    return chunk + CHUNK_HEADER;
+}
+
+void PoolAllocator::release(void* ptr) {
+    if (!ptr) return;
+    uint8_t* chunk = static_cast<uint8_t*>(ptr) - CHUNK_HEADER;
+    uint32_t sizeClass = *reinterpret_cast<uint32_t*>(chunk);
+    live--;
+    if (sizeClass == LARGE_CHUNK) {
+        countedFree(chunk, nullptr);
+        return;
+    }
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
+
+void PoolAllocator::refill(size_t sizeClass) {
+    uint8_t* slab = static_cast<uint8_t*>(countedAlloc(SLAB_BYTES, nullptr));
+    if (!slab) return;
+    // The first chunk-header's worth links the slabs for the destructor
+    *reinterpret_cast<void**>(slab) = slabs;
+    slabs = slab;
+    slabCount++;
+
+    const size_t chunk = SMALLEST_CHUNK << sizeClass;
+    for (size_t at = CHUNK_HEADER; at + chunk <= SLAB_BYTES; at += chunk) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + at);
+        block->next = freeLists[sizeClass];
+        freeLists[sizeClass] = block;
+    }
+}
+
+void* PoolAllocator::imguiAlloc(size_t bytes, void* user) {
+    return static_cast<PoolAllocator*>(user)->allocate(bytes);
+}
+
+void PoolAllocator::imguiFree(void* ptr, void* user) {
+    static_cast<PoolAllocator*>(user)->release(ptr);
+}
@@ -0,0 +1,111 @@
+#include "../include/ArcaneCache.h"
+#include "../include/ArcaneMath.h"
+#include <cmath>
+
+template <typename T>
+bool ArcaneSolveCache<T>::Key::operator==(const Key& other) const {
+    if (mask != other.mask) return false;
+    for (int i = 0; i < 8; i++) {
+        if (q[i] != other.q[i]) return false;
+    }
+    return true;
+}
+
+template <typename T>
+size_t ArcaneSolveCache<T>::KeyHash::operator()(const Key& key) const {
+    // FNV-1a over the mask and the quantized values
+    uint64_t h = 1469598103934665603ull ^ key.mask;
+    for (int i = 0; i < 8; i++) {
+        h = (h ^ (uint64_t)key.q[i]) * 1099511628211ull;
+    }
+    return (size_t)(h ^ (h >> 32));
+}
+
+template <typename T>
+ArcaneSolveCache<T>::ArcaneSolveCache(size_t capacity, T tolerance)
+    : capacity(capacity > 0 ? capacity : 1),
+      tolerance(tolerance > T(0) ? tolerance : T(1e-4)) {
+    index.reserve(this->capacity);
+}
+
+// Only known inputs take part in the key. Non-finite known values are dropped
+// here just as the ArcaneMath constructor drops them.
+template <typename T>
+typename ArcaneSolveCache<T>::Key ArcaneSolveCache<T>::makeKey(const T data[8], const bool known[8]) const {
+    Key key;
+    key.mask = 0;
+    for (int i = 0; i < 8; i++) {
+        key.q[i] = 0;
+        if (!known[i] || !std::isfinite(data[i])) continue;
+        T steps = std::round(data[i] / tolerance);
+        // Values too large to quantize still key exactly on their bits
+        if (std::abs(steps) < T(9.0e18)) key.q[i] = (int64_t)steps;
+        else key.q[i] = (int64_t)std::hash<T>()(data[i]);
+        key.mask |= 1u << i;
+    }
+    return key;
+}
+
+template <typename T>
+void ArcaneSolveCache<T>::solve(T data[8], bool known[8]) {
+    if (!data || !known) return;
+
+    const Key key = makeKey(data, known);
+    auto found = index.find(key);
+    if (found != index.end()) {
+        hitCount++;
+        entries.splice(entries.begin(), entries, found->second);
+        const Entry& entry = *found->second;
+        // Only the unknowns: the caller's inputs stay as typed, not as the
+        // neighbour within tolerance that made the entry had them
+        const unsigned unknown = entry.solvedMask & ~key.mask;
+        for (int i = 0; i < 8; i++) {
+            if (unknown & (1u << i)) data[i] = entry.result[i];
+        }
+        return;
+    }
+
+    missCount++;
+    ArcaneMath<T> math(data, known);
+    math.solve();
+    math.writeToArray(data);
+
+    Entry entry;
+    entry.key = key;
+    for (int i = 0; i < 8; i++) entry.result[i] = data[i];
+    entry.solvedMask = math.getKnownMask();
+    entries.push_front(entry);
+    index[key] = entries.begin();
+    evictToCapacity();
+}
+
+template <typename T>
+void ArcaneSolveCache<T>::setTolerance(T newTolerance) {
+    if (!(newTolerance > T(0)) || newTolerance == tolerance) return;
+    tolerance = newTolerance;
+    clear();
+}
+
+template <typename T>
+void ArcaneSolveCache<T>::setCapacity(size_t newCapacity) {
+    capacity = newCapacity > 0 ? newCapacity : 1;
+    evictToCapacity();
+}
+
+template <typename T>
+void ArcaneSolveCache<T>::clear() {
+    entries.clear();
+    index.clear();
+}
+
+template <typename T>
+void ArcaneSolveCache<T>::evictToCapacity() {
+    while (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+template class ArcaneSolveCache<float>;
+template class ArcaneSolveCache<double>;
+template class ArcaneSolveCache<long double>;
@@ -0,0 +1,49 @@
+#include "../include/ArcaneClock.h"
+#include <algorithm>
+
+namespace {
+
+// Longest wall-clock gap one frame may feed in (window drags, breakpoints, sleep)
+const double MAX_FRAME_SECONDS = 0.25;
+
+} // namespace
+
+SimulationClock::SimulationClock(double step, int maxStepsPerFrame)
+    : step(step > 0.0 ? step : 1.0 / 240.0), maxSteps(std::max(maxStepsPerFrame, 0)) {}
+
+void SimulationClock::start(double wallNow) {
+    lastWall = wallNow;
+    accumulator = 0.0;
+    stepCount = 0;
+    pendingSteps = 0;
+    dropped = 0.0;
+}
+
+void SimulationClock::setPaused(bool value, double wallNow) {
+    if (isPaused && !value) lastWall = wallNow;
+    isPaused = value;
+}
+
+int SimulationClock::advance(double wallNow) {
+    double wall = std::max(wallNow - lastWall, 0.0);
+    double frame = std::min(wall, MAX_FRAME_SECONDS);
+    lastWall = wallNow;
+
+    int steps = pendingSteps;
+    pendingSteps = 0;
+    if (!isPaused) {
+        dropped += (wall - frame) * scale;
+        accumulator += frame * scale;
+        int due = (int)(accumulator / step);
+        int run = maxSteps > 0 ? std::min(due, std::max(maxSteps - steps, 0)) : due;
+        accumulator -= run * step;
+        if (run < due) {
+            // Over budget: drop whole steps, keep the fraction for interpolation
+            dropped += (due - run) * step;
+            accumulator -= (due - run) * step;
+        }
+        steps += run;
+    }
+    stepCount += steps;
+    return steps;
+}
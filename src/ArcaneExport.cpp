@@ -0,0 +1,203 @@
+#include "../include/ArcaneExport.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Largest payload of a deflate stored block
+const size_t STORED_BLOCK = 65535;
+// Most bytes Adler-32 can sum before its 32-bit sums must be reduced
+const size_t ADLER_RUN = 5552;
+
+uint32_t crcTable[256];
+std::once_flag crcOnce;
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length) {
+    std::call_once(crcOnce, []() {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crcTable[n] = c;
+        }
+    });
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back((uint8_t)(value >> 24));
+    out.push_back((uint8_t)(value >> 16));
+    out.push_back((uint8_t)(value >> 8));
+    out.push_back((uint8_t)value);
+}
+
+void putChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t length) {
+    putBigEndian(out, (uint32_t)length);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + length);
+    putBigEndian(out, crc32(0, out.data() + start, length + 4));
+}
+
+} // namespace
+
+bool writePng(const char* path, const uint8_t* rgba, int width, int height, bool bottomUp) {
+    if (width <= 0 || height <= 0) return false;
+    const size_t row = (size_t)width * 4;
+    const size_t raw = (row + 1) * (size_t)height; // each row is prefixed with filter type 0
+
+    // zlib stream: header, stored deflate blocks, Adler-32 of the raw rows
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw + raw / STORED_BLOCK * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t a = 1, b = 0;
+    size_t done = 0, blockLeft = 0;
+    auto append = [&](const uint8_t* data, size_t length) {
+        while (length > 0) {
+            if (blockLeft == 0) {
+                size_t remaining = raw - done;
+                blockLeft = std::min(remaining, STORED_BLOCK);
+                const uint8_t header[5] = { (uint8_t)(remaining <= STORED_BLOCK ? 1 : 0),
+                                            (uint8_t)blockLeft, (uint8_t)(blockLeft >> 8),
+                                            (uint8_t)~blockLeft, (uint8_t)(~blockLeft >> 8) };
+                zlib.insert(zlib.end(), header, header + 5);
+            }
+            size_t n = std::min(length, blockLeft);
+            zlib.insert(zlib.end(), data, data + n);
+            // Adler-32, reduced every ADLER_RUN bytes
+            for (size_t i = 0; i < n;) {
+                size_t run = std::min(n - i, ADLER_RUN);
+                for (size_t k = 0; k < run; k++) {
+                    a += data[i + k];
+                    b += a;
+                }
+                a %= 65521;
+                b %= 65521;
+                i += run;
+            }
+            data += n;
+            length -= n;
+            blockLeft -= n;
+            done += n;
+        }
+    };
+    const uint8_t filterNone = 0;
+    for (int y = 0; y < height; y++) {
+        append(&filterNone, 1);
+        append(rgba + row * (size_t)(bottomUp ? height - 1 - y : y), row);
+    }
+    putBigEndian(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> png;
+    png.reserve(zlib.size() + 64);
+    static const uint8_t SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    png.insert(png.end(), SIGNATURE, SIGNATURE + 8);
+    std::vector<uint8_t> header;
+    putBigEndian(header, (uint32_t)width);
+    putBigEndian(header, (uint32_t)height);
+    const uint8_t format[5] = { 8, 6, 0, 0, 0 }; // 8-bit RGBA, no interlace
+    header.insert(header.end(), format, format + 5);
+    putChunk(png, "IHDR", header.data(), header.size());
+    putChunk(png, "IDAT", zlib.data(), zlib.size());
+    putChunk(png, "IEND", nullptr, 0);
+
+    FILE* out = std::fopen(path, "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(png.data(), 1, png.size(), out) == png.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+FrameEncoder::FrameEncoder(ExportFormat format, const char* path, unsigned threads, size_t maxQueued)
+    : format(format) {
+    TaskScheduler& scheduler = TaskScheduler::select(threads, ownScheduler);
+    tasks.reset(new TaskGroup(scheduler));
+    this->maxQueued = maxQueued > 0 ? maxQueued : 2 * (size_t)scheduler.workerCount();
+    if (format == ExportFormat::RawVideo) {
+        stream = path ? std::fopen(path, "wb") : nullptr;
+        if (!stream) failed = true;
+    }
+}
+
+FrameEncoder::~FrameEncoder() {
+    finish();
+    tasks.reset();
+    if (stream) std::fclose(stream);
+}
+
+std::vector<uint8_t> FrameEncoder::acquire(int width, int height) {
+    std::vector<uint8_t> pixels;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!spare.empty()) {
+            pixels = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    pixels.resize((size_t)width * (size_t)height * 4);
+    return pixels;
+}
+
+void FrameEncoder::submit(std::vector<uint8_t>&& pixels, int width, int height, const std::string& pngPath) {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [&]() { return inFlight < maxQueued; });
+    inFlight++;
+    Job job{ std::move(pixels), width, height, pngPath };
+    if (format == ExportFormat::RawVideo) {
+        rawQueue.push_back(std::move(job));
+        if (rawDraining) return;
+        rawDraining = true;
+        lock.unlock();
+        tasks->run([this]() { drainRaw(); });
+    } else {
+        lock.unlock();
+        std::shared_ptr<Job> shared = std::make_shared<Job>(std::move(job));
+        tasks->run([this, shared]() { encodePng(*shared); });
+    }
+}
+
+bool FrameEncoder::finish() {
+    tasks->wait();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stream && std::fflush(stream) != 0) failed = true;
+    return !failed;
+}
+
+void FrameEncoder::encodePng(Job& job) {
+    finishJob(job, writePng(job.path.c_str(), job.pixels.data(), job.width, job.height, true));
+}
+
+void FrameEncoder::drainRaw() {
+    // Only one drain runs at a time, so frames reach the stream in submission
+    // order, flipped to top-down rows
+    while (true) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (rawQueue.empty()) {
+                rawDraining = false;
+                return;
+            }
+            job = std::move(rawQueue.front());
+            rawQueue.pop_front();
+        }
+        bool ok = stream != nullptr;
+        const size_t row = (size_t)job.width * 4;
+        for (int y = job.height - 1; ok && y >= 0; y--) {
+            ok = std::fwrite(job.pixels.data() + row * (size_t)y, 1, row, stream) == row;
+        }
+        finishJob(job, ok);
+    }
+}
+
+void FrameEncoder::finishJob(Job& job, bool ok) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ok) failed = true;
+        else written++;
+        spare.push_back(std::move(job.pixels));
+        inFlight--;
+    }
+    jobDone.notify_all();
+}
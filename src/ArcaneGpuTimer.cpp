@@ -0,0 +1,106 @@
+#include "../include/ArcaneGpuTimer.h"
+#include <algorithm>
+#include <cstring>
+
+const int GpuTimer::FRAMES_IN_FLIGHT;
+const int GpuTimer::MAX_PASSES;
+const int GpuTimer::HISTORY;
+
+GpuTimer& GpuTimer::instance() {
+    static GpuTimer timer;
+    return timer;
+}
+
+bool GpuTimer::init() {
+    ready = GLAD_GL_VERSION_3_3 && glGetQueryObjectui64v != nullptr;
+    if (!ready) return false;
+    for (Slot& slot : slots) {
+        glGenQueries(MAX_PASSES, slot.queries);
+        slot.issued = 0;
+        slot.pending = false;
+    }
+    return true;
+}
+
+void GpuTimer::shutdown() {
+    if (!ready) return;
+    for (Slot& slot : slots) glDeleteQueries(MAX_PASSES, slot.queries);
+    ready = false;
+}
+
+int GpuTimer::passIndex(const char* pass) {
+    for (int i = 0; i < passes; ++i) {
+        if (names[i] == pass || std::strcmp(names[i], pass) == 0) return i;
+    }
+    if (passes == MAX_PASSES) return -1;
+    names[passes] = pass;
+    samples[passes] = 0;
+    return passes++;
+}
+
+void GpuTimer::collect(Slot& slot) {
+    // Queries finish in order, so the last one being available means all are
+    GLint available = 0;
+    glGetQueryObjectiv(slot.queries[slot.issued - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+    for (int i = 0; i < slot.issued; ++i) {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &ns);
+        int pass = slot.pass[i];
+        history[pass][samples[pass] % HISTORY] = (float)(ns * 1e-6);
+        samples[pass]++;
+    }
+    slot.pending = false;
+}
+
+void GpuTimer::beginFrame() {
+    if (!ready) return;
+    if (open) end();
+    // Oldest first, so each pass's history stays in frame order
+    for (int i = 1; i <= FRAMES_IN_FLIGHT; ++i) {
+        Slot& slot = slots[(current + i) % FRAMES_IN_FLIGHT];
+        if (slot.pending && slot.issued > 0) collect(slot);
+    }
+    current = (current + 1) % FRAMES_IN_FLIGHT;
+    Slot& slot = slots[current];
+    if (slot.pending) dropped++;
+    slot.issued = 0;
+    slot.pending = false;
+}
+
+void GpuTimer::begin(const char* pass) {
+    Slot& slot = slots[current];
+    if (!ready || open || slot.issued == MAX_PASSES) return;
+    int index = passIndex(pass);
+    if (index < 0) return;
+    slot.pass[slot.issued] = index;
+    glBeginQuery(GL_TIME_ELAPSED, slot.queries[slot.issued]);
+    open = true;
+}
+
+void GpuTimer::end() {
+    if (!ready || !open) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    Slot& slot = slots[current];
+    slot.issued++;
+    slot.pending = true;
+    open = false;
+}
+
+float GpuTimer::lastMs(int pass) const {
+    return samples[pass] > 0 ? history[pass][(samples[pass] - 1) % HISTORY] : 0.0f;
+}
+
+float GpuTimer::meanMs(int pass) const {
+    int n = std::min(samples[pass], HISTORY);
+    float sum = 0.0f;
+    for (int i = 0; i < n; ++i) sum += history[pass][i];
+    return n > 0 ? sum / (float)n : 0.0f;
+}
+
+float GpuTimer::maxMs(int pass) const {
+    int n = std::min(samples[pass], HISTORY);
+    float peak = 0.0f;
+    for (int i = 0; i < n; ++i) peak = std::max(peak, history[pass][i]);
+    return peak;
+}
@@ -0,0 +1,232 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "../include/ArcaneHeadless.h"
+#include "../include/ArcaneAllocations.h"
+#include "../include/ArcaneIO.h"
+#include "../include/ArcaneOffscreen.h"
+#include "../include/ArcaneProfiler.h"
+#include "../include/GUIRender.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Frames drawn per scenario: the first lays out the canvas, and with the
+// pixel-error policy resamples the path for its scale (waited for, see
+// GUIRender::SetScenario); the second shows that path and is captured
+const int FRAMES_PER_SCENARIO = 2;
+// Allocation check: frames for ImGui, ImPlot and the caches to reach their
+// working sizes, then the frames that must not allocate
+const int WARMUP_FRAMES = 60;
+const int CHECKED_FRAMES = 240;
+
+struct Scenario {
+    float v0, thetaDeg, h0, g;
+};
+
+bool loadScenarios(const char* path, std::vector<Scenario>& scenarios) {
+    ArcaneLineReader reader;
+    if (!reader.open(path)) return false;
+    const char* begin;
+    const char* end;
+    while (reader.next(begin, end)) {
+        const char* p = begin;
+        while (p < end) {
+            const char* lineEnd = p;
+            while (lineEnd < end && *lineEnd != '\n') lineEnd++;
+            double values[4];
+            int found = 0;
+            const char* q = p;
+            while (found < 4 && q < lineEnd) {
+                if (*q == '#') break;
+                if (parseNumber(q, lineEnd, values[found])) found++;
+                else q++;
+            }
+            // Headers, comments and short lines are skipped
+            if (found == 4) {
+                scenarios.push_back({ (float)values[0], (float)values[1], (float)values[2], (float)values[3] });
+            }
+            p = lineEnd + 1;
+        }
+    }
+    return true;
+}
+
+// No display needed: GLFW 3.4's null platform with an OSMesa or EGL context.
+// Older GLFW, or neither API available, falls back to a hidden window.
+GLFWwindow* createHeadlessWindow(int width, int height) {
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+#if defined(GLFW_PLATFORM_NULL) && defined(GLFW_OSMESA_CONTEXT_API)
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (glfwInit()) {
+        for (int api : { GLFW_OSMESA_CONTEXT_API, GLFW_EGL_CONTEXT_API }) {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+            if (GLFWwindow* window = glfwCreateWindow(width, height, "Arcane Dynamics", NULL, NULL)) return window;
+        }
+        glfwTerminate();
+    }
+    glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+#endif
+    if (!glfwInit()) return nullptr;
+    return glfwCreateWindow(width, height, "Arcane Dynamics", NULL, NULL);
+}
+
+// Draws the UI into the bound target, unchanged input, and counts the frame
+// thread's heap allocations over each checked frame
+int checkSteadyState(GUIRender& GUI, GLFWwindow* window) {
+    int allocatingFrames = 0;
+    AllocationCount worst;
+    for (int frame = 0; frame < WARMUP_FRAMES + CHECKED_FRAMES; ++frame) {
+        AllocationCount before = threadAllocations();
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        GUI.NewFrame();
+        GUI.Update(window);
+        GUI.Render();
+        ARCANE_PROFILE_FRAME();
+        if (frame < WARMUP_FRAMES) continue;
+
+        AllocationCount after = threadAllocations();
+        uint64_t count = after.count - before.count;
+        if (count == 0) continue;
+        allocatingFrames++;
+        if (count > worst.count) {
+            worst.count = count;
+            worst.bytes = after.bytes - before.bytes;
+        }
+    }
+
+    std::cerr << CHECKED_FRAMES << " steady-state frames after " << WARMUP_FRAMES << " warm-up: "
+              << allocatingFrames << " allocated";
+    if (allocatingFrames > 0) std::cerr << " (worst " << worst.count << " allocations, " << worst.bytes << " bytes)";
+    std::cerr << std::endl;
+    return allocatingFrames == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int runHeadless(const HeadlessOptions& options) {
+    if (options.checkAllocations && !allocationTrackingEnabled()) {
+        std::cerr << "Error: allocation checks need a build with ARCANE_TRACK_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+    std::vector<Scenario> scenarios;
+    // The allocation check runs on the default inputs when no file is given
+    const bool needScenarios = !options.checkAllocations || options.scenarioPath;
+    if (needScenarios && (!options.scenarioPath || !loadScenarios(options.scenarioPath, scenarios))) {
+        std::cerr << "Error: cannot read scenarios from " << (options.scenarioPath ? options.scenarioPath : "(none)") << std::endl;
+        return 1;
+    }
+    if (scenarios.empty() && !options.checkAllocations) {
+        std::cerr << "Warning: no scenarios (expected v0,theta,h0,g per line)" << std::endl;
+        return 0;
+    }
+
+    GLFWwindow* window = createHeadlessWindow(options.width, options.height);
+    if (!window) {
+        std::cerr << "Error: could not create an offscreen GL context" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Error: could not load OpenGL" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+
+    // The UI lays out in window coordinates; the target matches the framebuffer
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    OffscreenTarget target;
+    if (!target.create(fbWidth, fbHeight)) {
+        std::cerr << "Error: offscreen framebuffer incomplete" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+
+    GUIRender GUI;
+    GUI.Init(window, "#version 150");
+    ImGui::GetIO().IniFilename = nullptr; // leave the interactive layout alone
+
+    if (options.checkAllocations) {
+        if (!scenarios.empty()) {
+            const Scenario& s = scenarios.front();
+            GUI.SetScenario(s.v0, s.thetaDeg, s.h0, s.g);
+        }
+        target.bind();
+        int code = checkSteadyState(GUI, window);
+        target.unbind();
+        target.destroy();
+        GUI.Shutdown();
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return code;
+    }
+
+    const std::string dir = options.outDir;
+    const std::string rawPath = dir + "/scenarios.rgba";
+    FrameEncoder encoder(options.format, rawPath.c_str(), options.threads);
+    if (!encoder.ok()) {
+        std::cerr << "Error: cannot write " << rawPath << std::endl;
+        target.destroy();
+        GUI.Shutdown();
+        glfwTerminate();
+        return 1;
+    }
+
+    auto submit = [&](std::vector<uint8_t>& pixels, int index) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/scenario_%06d.png", index);
+        encoder.submit(std::move(pixels), target.width(), target.height(), dir + name);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> pixels;
+    int ready = 0;
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        const Scenario& s = scenarios[i];
+        GUI.SetScenario(s.v0, s.thetaDeg, s.h0, s.g);
+        target.bind();
+        for (int frame = 0; frame < FRAMES_PER_SCENARIO; ++frame) {
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            GUI.NewFrame();
+            GUI.Update(window);
+            GUI.Render();
+        }
+        pixels = encoder.acquire(target.width(), target.height());
+        if (target.capture((int)i, pixels, ready)) submit(pixels, ready);
+    }
+    pixels = encoder.acquire(target.width(), target.height());
+    if (target.drain(pixels, ready)) submit(pixels, ready);
+    target.unbind();
+
+    bool ok = encoder.finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << encoder.framesWritten() << " frames (" << target.width() << "x" << target.height() << ") in "
+              << seconds << " s, " << encoder.framesWritten() / std::max(seconds, 1e-9) << " frames/s" << std::endl;
+    if (options.format == ExportFormat::RawVideo) {
+        std::cerr << "Raw RGBA stream: " << rawPath << " (ffmpeg -f rawvideo -pix_fmt rgba -s "
+                  << target.width() << "x" << target.height() << " -i " << rawPath << " ...)" << std::endl;
+    }
+    if (!ok) std::cerr << "Error: some frames could not be written" << std::endl;
+
+    target.destroy();
+    GUI.Shutdown();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return ok ? 0 : 1;
+}
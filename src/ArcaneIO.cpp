@@ -0,0 +1,327 @@
+#include "../include/ArcaneIO.h"
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define ARCANE_IO_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// Exactly representable powers of ten for the fast path
+const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const size_t MAP_BLOCK = 8u << 20;    // bytes of mapped input per next()
+const size_t STREAM_BLOCK = 4u << 20; // bytes read per next() when streaming
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+template <typename T>
+char* formatWithCharconv(char* out, char* end, T value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::to_chars_result result = std::to_chars(out, end, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+    int n = std::snprintf(out, (size_t)(end - out), "%.*Lg",
+                          sizeof(T) == sizeof(float) ? 9 : 17, (long double)value);
+    return (n >= 0 && n < end - out) ? out + n : nullptr;
+#endif
+}
+
+} // namespace
+
+bool parseNumber(const char*& p, const char* end, double& value) {
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-')) {
+        negative = (*s == '-');
+        ++s;
+    }
+
+    uint64_t mantissa = 0;
+    int significant = 0; // digits kept in mantissa, ignoring leading zeros
+    int exponent = 0;
+    bool anyDigits = false;
+
+    while (s < end && isDigit(*s)) {
+        anyDigits = true;
+        if (significant < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+            if (mantissa != 0) significant++;
+        } else {
+            exponent++;
+        }
+        ++s;
+    }
+    if (s < end && *s == '.') {
+        ++s;
+        while (s < end && isDigit(*s)) {
+            anyDigits = true;
+            if (significant < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+                if (mantissa != 0) significant++;
+                exponent--;
+            }
+            ++s;
+        }
+    }
+    if (!anyDigits) return false;
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool expNegative = false;
+        if (e < end && (*e == '+' || *e == '-')) {
+            expNegative = (*e == '-');
+            ++e;
+        }
+        if (e >= end || !isDigit(*e)) return false;
+        int expValue = 0;
+        while (e < end && isDigit(*e)) {
+            if (expValue < 10000) expValue = expValue * 10 + (*e - '0');
+            ++e;
+        }
+        exponent += expNegative ? -expValue : expValue;
+        s = e;
+    }
+
+    if (significant <= 15 && exponent >= -22 && exponent <= 22) {
+        // Both operands are exact doubles, so one multiply/divide rounds correctly
+        double m = (double)mantissa;
+        value = exponent < 0 ? m / POW10[-exponent] : m * POW10[exponent];
+    } else {
+        char text[128];
+        size_t length = (size_t)(s - p);
+        if (length >= sizeof(text)) return false;
+        std::memcpy(text, p, length);
+        text[length] = '\0';
+        value = std::strtod(text, nullptr);
+        p = s;
+        return true;
+    }
+    if (negative) value = -value;
+    p = s;
+    return true;
+}
+
+char* formatNumber(char* out, char* end, float value) {
+    return formatWithCharconv(out, end, value);
+}
+
+char* formatNumber(char* out, char* end, double value) {
+    return formatWithCharconv(out, end, value);
+}
+
+char* formatNumber(char* out, char* end, long double value) {
+    int n = std::snprintf(out, (size_t)(end - out), "%.21Lg", value);
+    return (n >= 0 && n < end - out) ? out + n : nullptr;
+}
+
+bool parseJsonFields(const char* begin, const char* end, const char* const names[], int count,
+                     double values[], unsigned& found) {
+    found = 0;
+    bool ok = true;
+    const char* p = begin;
+    while (p < end) {
+        // key
+        while (p < end && *p != '"') p++;
+        if (p >= end) break;
+        const char* key = ++p;
+        while (p < end && *p != '"') p++;
+        if (p >= end) return false;
+        int target = -1;
+        for (int k = 0; k < count; k++) {
+            if (std::strlen(names[k]) == (size_t)(p - key) && !std::memcmp(names[k], key, (size_t)(p - key))) {
+                target = k;
+                break;
+            }
+        }
+        p++;
+
+        while (p < end && (isBlank(*p) || *p == ':')) p++;
+        if (p >= end) return false;
+
+        // value
+        if (*p == '"') {
+            p++;
+            while (p < end && *p != '"') {
+                if (*p == '\\' && end - p < 2) break; // escape cut off by the line end
+                p += (*p == '\\') ? 2 : 1;
+            }
+            if (p >= end || *p != '"') return false;
+            p++;
+        } else if (*p == 'n') {
+            if (end - p < 4 || std::strncmp(p, "null", 4) != 0) return false;
+            p += 4;
+        } else {
+            double value;
+            if (parseNumber(p, end, value)) {
+                if (target >= 0) {
+                    values[target] = value;
+                    found |= 1u << target;
+                }
+            } else {
+                ok = false;
+            }
+        }
+        while (p < end && *p != ',' && *p != '}') p++;
+        if (p < end) p++;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// ArcaneLineReader
+// ---------------------------------------------------------------------------
+
+ArcaneLineReader::~ArcaneLineReader() {
+    close();
+}
+
+bool ArcaneLineReader::open(const char* path) {
+    close();
+    const bool useStdin = (path == nullptr || std::strcmp(path, "-") == 0);
+
+#ifdef ARCANE_IO_MMAP
+    if (!useStdin) {
+        int handle = ::open(path, O_RDONLY);
+        if (handle < 0) return false;
+        struct stat info;
+        if (fstat(handle, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, handle, 0);
+            if (view != MAP_FAILED) {
+                madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+                mapped = static_cast<const char*>(view);
+                mappedSize = (size_t)info.st_size;
+                mappedOffset = 0;
+                fd = handle;
+                return true;
+            }
+        }
+        ::close(handle);
+    }
+#endif
+
+    if (useStdin) {
+        file = stdin;
+        ownsFile = false;
+    } else {
+        file = std::fopen(path, "rb");
+        if (!file) return false;
+        ownsFile = true;
+    }
+    buffer.resize(STREAM_BLOCK);
+    pendingBegin = pendingEnd = 0;
+    eof = false;
+    return true;
+}
+
+void ArcaneLineReader::close() {
+#ifdef ARCANE_IO_MMAP
+    if (mapped) munmap(const_cast<char*>(mapped), mappedSize);
+    if (fd >= 0) ::close(fd);
+#endif
+    mapped = nullptr;
+    mappedSize = mappedOffset = 0;
+    fd = -1;
+
+    if (file && ownsFile) std::fclose(file);
+    file = nullptr;
+    ownsFile = false;
+    eof = false;
+    pendingBegin = pendingEnd = 0;
+}
+
+bool ArcaneLineReader::next(const char*& begin, const char*& end) {
+    if (mapped) {
+        if (mappedOffset >= mappedSize) return false;
+        size_t stop = mappedOffset + MAP_BLOCK;
+        if (stop >= mappedSize) {
+            stop = mappedSize;
+        } else {
+            // extend to the end of the line the block boundary falls in
+            const void* nl = std::memchr(mapped + stop, '\n', mappedSize - stop);
+            stop = nl ? (size_t)(static_cast<const char*>(nl) - mapped) + 1 : mappedSize;
+        }
+        begin = mapped + mappedOffset;
+        end = mapped + stop;
+        mappedOffset = stop;
+        return true;
+    }
+
+    if (!file) return false;
+
+    // The caller is done with the previous block, so the unfinished line it
+    // left behind can move to the front of the buffer
+    size_t filled = pendingEnd - pendingBegin;
+    if (filled > 0) std::memmove(buffer.data(), buffer.data() + pendingBegin, filled);
+    pendingBegin = pendingEnd = 0;
+
+    while (!eof) {
+        if (filled == buffer.size()) buffer.resize(buffer.size() * 2); // a line longer than the buffer
+        size_t got = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file);
+        if (got == 0) {
+            eof = true;
+            break;
+        }
+        filled += got;
+
+        size_t lastNewline = filled;
+        while (lastNewline > 0 && buffer[lastNewline - 1] != '\n') lastNewline--;
+        if (lastNewline == 0) continue; // no complete line yet
+
+        begin = buffer.data();
+        end = buffer.data() + lastNewline;
+        pendingBegin = lastNewline;
+        pendingEnd = filled;
+        return true;
+    }
+
+    // Final line without a trailing newline
+    if (filled == 0) return false;
+    begin = buffer.data();
+    end = buffer.data() + filled;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// ArcaneWriter
+// ---------------------------------------------------------------------------
+
+ArcaneWriter::ArcaneWriter(FILE* out, size_t capacity)
+    : out(out), buffer(capacity > 0 ? capacity : 4096) {}
+
+ArcaneWriter::~ArcaneWriter() {
+    flush();
+}
+
+char* ArcaneWriter::reserve(size_t bytes) {
+    if (buffer.size() - used < bytes) {
+        flush();
+        if (buffer.size() < bytes) buffer.resize(bytes);
+    }
+    return buffer.data() + used;
+}
+
+void ArcaneWriter::write(const char* text, size_t length) {
+    char* dst = reserve(length);
+    std::memcpy(dst, text, length);
+    used += length;
+}
+
+bool ArcaneWriter::flush() {
+    if (used > 0 && out) {
+        if (std::fwrite(buffer.data(), 1, used, out) != used) error = true;
+    }
+    used = 0;
+    return !error;
+}
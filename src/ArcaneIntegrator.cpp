@@ -0,0 +1,236 @@
+#include "../include/ArcaneIntegrator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Position and velocity; also used for their time derivatives
+struct State {
+    double x, y, vx, vy;
+};
+
+inline State axpy(const State& s, double h, const State& k) {
+    return { s.x + h * k.x, s.y + h * k.y, s.vx + h * k.vx, s.vy + h * k.vy };
+}
+
+inline double maxAbs(const State& s) {
+    return std::max(std::max(std::abs(s.x), std::abs(s.y)), std::max(std::abs(s.vx), std::abs(s.vy)));
+}
+
+struct Model {
+    double g;
+    double k;
+    DragModel drag;
+
+    State derivative(const State& s) const {
+        double c = 0.0;
+        if (drag == DragModel::Linear) c = k;
+        else if (drag == DragModel::Quadratic) c = k * std::sqrt(s.vx * s.vx + s.vy * s.vy);
+        return { s.vx, s.vy, -c * s.vx, -g - c * s.vy };
+    }
+};
+
+// Classic RK4; k1 is the derivative at s, already known to the caller
+State stepRK4(const Model& m, const State& s, const State& k1, double h) {
+    State k2 = m.derivative(axpy(s, 0.5 * h, k1));
+    State k3 = m.derivative(axpy(s, 0.5 * h, k2));
+    State k4 = m.derivative(axpy(s, h, k3));
+    return {
+        s.x + h / 6.0 * (k1.x + 2.0 * k2.x + 2.0 * k3.x + k4.x),
+        s.y + h / 6.0 * (k1.y + 2.0 * k2.y + 2.0 * k3.y + k4.y),
+        s.vx + h / 6.0 * (k1.vx + 2.0 * k2.vx + 2.0 * k3.vx + k4.vx),
+        s.vy + h / 6.0 * (k1.vy + 2.0 * k2.vy + 2.0 * k3.vy + k4.vy)
+    };
+}
+
+// Dormand-Prince 5(4) step. The 5th-order result goes to next and its
+// derivative (the FSAL stage) to nextDerivative; error gets the difference
+// to the embedded 4th-order solution.
+void stepDormandPrince(const Model& m, const State& s, const State& k1, double h,
+                       State& next, State& nextDerivative, State& error) {
+    auto combine = [&](std::initializer_list<std::pair<double, const State*>> terms) {
+        State r = s;
+        for (const auto& term : terms) r = axpy(r, h * term.first, *term.second);
+        return r;
+    };
+    State k2 = m.derivative(combine({ { 1.0 / 5.0, &k1 } }));
+    State k3 = m.derivative(combine({ { 3.0 / 40.0, &k1 }, { 9.0 / 40.0, &k2 } }));
+    State k4 = m.derivative(combine({ { 44.0 / 45.0, &k1 }, { -56.0 / 15.0, &k2 }, { 32.0 / 9.0, &k3 } }));
+    State k5 = m.derivative(combine({ { 19372.0 / 6561.0, &k1 }, { -25360.0 / 2187.0, &k2 },
+                                      { 64448.0 / 6561.0, &k3 }, { -212.0 / 729.0, &k4 } }));
+    State k6 = m.derivative(combine({ { 9017.0 / 3168.0, &k1 }, { -355.0 / 33.0, &k2 },
+                                      { 46732.0 / 5247.0, &k3 }, { 49.0 / 176.0, &k4 },
+                                      { -5103.0 / 18656.0, &k5 } }));
+    next = combine({ { 35.0 / 384.0, &k1 }, { 500.0 / 1113.0, &k3 }, { 125.0 / 192.0, &k4 },
+                     { -2187.0 / 6784.0, &k5 }, { 11.0 / 84.0, &k6 } });
+    nextDerivative = m.derivative(next);
+
+    const State zero = { 0.0, 0.0, 0.0, 0.0 };
+    State e = zero;
+    e = axpy(e, h * 71.0 / 57600.0, k1);
+    e = axpy(e, h * -71.0 / 16695.0, k3);
+    e = axpy(e, h * 71.0 / 1920.0, k4);
+    e = axpy(e, h * -17253.0 / 339200.0, k5);
+    e = axpy(e, h * 22.0 / 525.0, k6);
+    e = axpy(e, h * -1.0 / 40.0, nextDerivative);
+    error = e;
+}
+
+// Cubic Hermite interpolation across one step, u in [0, 1]. Positions use
+// the velocities as slopes and velocities use the accelerations.
+State interpolate(const State& s0, const State& f0, const State& s1, const State& f1, double h, double u) {
+    double u2 = u * u, u3 = u2 * u;
+    double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+    double h10 = (u3 - 2.0 * u2 + u) * h;
+    double h01 = -2.0 * u3 + 3.0 * u2;
+    double h11 = (u3 - u2) * h;
+    return {
+        h00 * s0.x + h10 * f0.x + h01 * s1.x + h11 * f1.x,
+        h00 * s0.y + h10 * f0.y + h01 * s1.y + h11 * f1.y,
+        h00 * s0.vx + h10 * f0.vx + h01 * s1.vx + h11 * f1.vx,
+        h00 * s0.vy + h10 * f0.vy + h01 * s1.vy + h11 * f1.vy
+    };
+}
+
+// Fraction of the step where the interpolated y crosses ground, given that
+// it is above ground at u = 0 and below at u = 1 (Illinois false position)
+double refineImpact(const State& s0, const State& f0, const State& s1, const State& f1,
+                    double h, double ground) {
+    double a = 0.0, b = 1.0;
+    double ya = s0.y - ground, yb = s1.y - ground;
+    int side = 0;
+    for (int i = 0; i < 60 && (b - a) * h > 1e-12; i++) {
+        double u = (a * yb - b * ya) / (yb - ya);
+        if (!(u > a && u < b)) u = 0.5 * (a + b);
+        double yu = interpolate(s0, f0, s1, f1, h, u).y - ground;
+        if (yu == 0.0) return u;
+        if (yu > 0.0) {
+            a = u; ya = yu;
+            if (side == -1) yb *= 0.5;
+            side = -1;
+        } else {
+            b = u; yb = yu;
+            if (side == 1) ya *= 0.5;
+            side = 1;
+        }
+    }
+    return 0.5 * (a + b);
+}
+
+void writeSample(const TrajectorySamples& out, size_t i, double t, const State& s) {
+    if (out.t) out.t[i] = (float)t;
+    if (out.x) out.x[i] = (float)s.x;
+    if (out.y) out.y[i] = (float)s.y;
+    if (out.vx) out.vx[i] = (float)s.vx;
+    if (out.vy) out.vy[i] = (float)s.vy;
+    if (out.speed) out.speed[i] = (float)std::sqrt(s.vx * s.vx + s.vy * s.vy);
+}
+
+} // namespace
+
+size_t integrateTrajectory(const TrajectoryParams& params, const IntegratorOptions& options,
+                           double t0, double dt, size_t count,
+                           const TrajectorySamples& out, IntegratorStats* stats) {
+    IntegratorStats local;
+    IntegratorStats& st = stats ? *stats : local;
+    st = IntegratorStats();
+    st.errorEstimated = options.method == IntegratorMethod::DormandPrince || options.estimateRK4Error;
+
+    const Model model = { params.g, options.dragCoeff, options.drag };
+    const double minStep = std::max(options.minStep, 1e-12);
+    const double maxStep = std::max(options.maxStep, minStep);
+    const double tolerance = options.tolerance > 0.0 ? options.tolerance : 1e-6;
+
+    State s = { 0.0, params.h0, params.v0 * std::cos((double)params.theta), params.v0 * std::sin((double)params.theta) };
+    State f = model.derivative(s);
+    st.evaluations = 1;
+    double t = 0.0;
+    double h = std::min(std::max(options.step, minStep), maxStep);
+
+    size_t next = 0;
+    auto sampleTime = [&](size_t i) { return t0 + (double)i * dt; };
+    while (next < count && sampleTime(next) <= 0.0) {
+        writeSample(out, next, sampleTime(next), s);
+        next++;
+    }
+
+    while ((count == 0 || next < count) && t < options.maxTime) {
+        const double hTry = std::min(h, options.maxTime - t);
+        State s1, f1;
+        double localError = 0.0;
+        double scaledError = 0.0;
+
+        if (options.method == IntegratorMethod::RK4) {
+            s1 = stepRK4(model, s, f, hTry);
+            st.evaluations += 3;
+            if (options.estimateRK4Error) {
+                State half = stepRK4(model, s, f, 0.5 * hTry);
+                State halfF = model.derivative(half);
+                State twoHalves = stepRK4(model, half, halfF, 0.5 * hTry);
+                st.evaluations += 7;
+                State diff = { twoHalves.x - s1.x, twoHalves.y - s1.y, twoHalves.vx - s1.vx, twoHalves.vy - s1.vy };
+                localError = maxAbs(diff) / 15.0; // Richardson: the full step's error is ~16/15 of the difference
+            }
+            f1 = model.derivative(s1);
+            st.evaluations += 1;
+        } else {
+            State error;
+            stepDormandPrince(model, s, f, hTry, s1, f1, error);
+            st.evaluations += 6;
+            localError = maxAbs(error);
+            double scale = tolerance + tolerance * std::max(maxAbs(s), maxAbs(s1));
+            scaledError = localError / scale;
+            if (scaledError > 1.0 && hTry > minStep) {
+                st.rejected++;
+                h = std::max(minStep, hTry * std::max(0.2, 0.9 * std::pow(scaledError, -0.2)));
+                continue;
+            }
+        }
+
+        st.steps++;
+        st.maxLocalError = std::max(st.maxLocalError, localError);
+        st.sumLocalError += localError;
+
+        const bool landing = s.y >= options.groundY && s1.y < options.groundY;
+        const double u = landing ? refineImpact(s, f, s1, f1, hTry, options.groundY) : 1.0;
+        const double tStop = t + u * hTry;
+
+        while (next < count && sampleTime(next) <= tStop) {
+            double v = (sampleTime(next) - t) / hTry;
+            writeSample(out, next, sampleTime(next), interpolate(s, f, s1, f1, hTry, v));
+            next++;
+        }
+
+        if (landing) {
+            State impact = interpolate(s, f, s1, f1, hTry, u);
+            impact.y = options.groundY;
+            st.landed = true;
+            st.impactTime = tStop;
+            st.impactX = impact.x;
+            st.impactSpeed = std::sqrt(impact.vx * impact.vx + impact.vy * impact.vy);
+
+            const size_t inFlight = next;
+            for (; next < count; next++) writeSample(out, next, sampleTime(next), impact);
+            return inFlight;
+        }
+
+        t += hTry;
+        s = s1;
+        f = f1;
+        if (options.method == IntegratorMethod::DormandPrince) {
+            double grow = scaledError > 0.0 ? 0.9 * std::pow(scaledError, -0.2) : 5.0;
+            h = std::min(maxStep, std::max(minStep, hTry * std::min(5.0, std::max(0.2, grow))));
+        }
+    }
+
+    // Ran out of time before landing: hold the last state
+    const size_t reached = next;
+    for (; next < count; next++) writeSample(out, next, sampleTime(next), s);
+    return reached;
+}
+
+IntegratorStats findImpact(const TrajectoryParams& params, const IntegratorOptions& options) {
+    IntegratorStats stats;
+    integrateTrajectory(params, options, 0.0, 0.0, 0, TrajectorySamples(), &stats);
+    return stats;
+}
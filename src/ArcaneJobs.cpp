@@ -0,0 +1,80 @@
+#include "../include/ArcaneJobs.h"
+
+JobStatus JobHandle::status() const {
+    return control ? (JobStatus)control->status.load() : JobStatus::Finished;
+}
+
+bool JobHandle::done() const {
+    JobStatus s = status();
+    return s == JobStatus::Finished || s == JobStatus::Cancelled;
+}
+
+float JobHandle::progress() const {
+    return control ? control->progressValue.load(std::memory_order_relaxed) : 1.0f;
+}
+
+void JobHandle::cancel() {
+    if (control) control->cancelRequested = true;
+}
+
+void JobHandle::wait() {
+    if (!control) return;
+    std::unique_lock<std::mutex> lock(control->mutex);
+    control->ended.wait(lock, [&]() { return done(); });
+}
+
+BackgroundWorker::BackgroundWorker(std::function<void()> onFinished)
+    : onFinished(std::move(onFinished)) {
+    thread = std::thread(&BackgroundWorker::work, this);
+}
+
+BackgroundWorker::~BackgroundWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (Job& job : queue) job.control->cancelRequested = true;
+        if (running) running->cancelRequested = true;
+    }
+    jobReady.notify_all();
+    thread.join();
+}
+
+JobHandle BackgroundWorker::submit(std::function<void(JobControl&)> job) {
+    std::shared_ptr<JobControl> control = std::make_shared<JobControl>();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({ control, std::move(job) });
+    }
+    jobReady.notify_one();
+    return JobHandle(control);
+}
+
+void BackgroundWorker::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [&]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+            running = job.control;
+        }
+
+        JobControl& control = *job.control;
+        if (!control.cancelled()) {
+            control.status = (int)JobStatus::Running;
+            job.run(control);
+        }
+        {
+            std::lock_guard<std::mutex> lock(control.mutex);
+            control.status = (int)(control.cancelled() ? JobStatus::Cancelled : JobStatus::Finished);
+        }
+        control.ended.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.reset();
+        }
+        if (onFinished) onFinished();
+    }
+}
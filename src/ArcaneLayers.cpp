@@ -0,0 +1,131 @@
+#include <glad/glad.h>
+
+#include "../include/ArcaneLayers.h"
+#include <imgui_impl_opengl3.h>
+#include <cstdint>
+
+LayerCache::~LayerCache() {
+    if (list) IM_DELETE(list);
+}
+
+ImDrawList* LayerCache::begin(const LayerKey& key, ImVec2 canvasSize) {
+    if (failed || key.width <= 0 || key.height <= 0) return nullptr;
+    if (drawn && key == cached) return nullptr;
+    // Solid fills sample the font atlas' white pixel, like any window's list.
+    // From 1.92 the backend only creates the atlas texture while rendering a
+    // frame's draw data, so it is missing in the first Update(); draw
+    // directly until it exists rather than caching a black layer.
+#if IMGUI_VERSION_NUM >= 19200
+    const ImTextureRef atlas = ImGui::GetIO().Fonts->TexRef;
+    if (atlas.GetTexID() == ImTextureID_Invalid) return nullptr;
+#else
+    const ImTextureID atlas = ImGui::GetIO().Fonts->TexID;
+    if (!atlas) return nullptr;
+#endif
+
+    if (!list) list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    list->_ResetForNewFrame();
+    list->PushClipRect(ImVec2(0.0f, 0.0f), canvasSize);
+#if IMGUI_VERSION_NUM >= 19200
+    list->PushTexture(atlas);
+#else
+    list->PushTextureID(atlas);
+#endif
+    cached = key;
+    size = canvasSize;
+    drawn = false;
+    return list;
+}
+
+bool LayerCache::end() {
+    if (!resize(cached.width, cached.height)) {
+        failed = true;
+        destroy();
+        return false;
+    }
+
+    // Called mid-frame: put back the target, viewport and clear colour the
+    // frame loop set up (the backend restores the rest of its state itself)
+    GLint previousFbo = 0;
+    GLint viewport[4];
+    GLfloat clearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, textureWidth, textureHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    ImDrawData data;
+    data.Valid = true;
+    data.DisplayPos = ImVec2(0.0f, 0.0f);
+    data.DisplaySize = size;
+    data.FramebufferScale = ImVec2(textureWidth / size.x, textureHeight / size.y);
+#if IMGUI_VERSION_NUM >= 18980
+    data.AddDrawList(list);
+#else
+    ImDrawList* lists[] = { list };
+    data.CmdLists = lists;
+    data.CmdListsCount = 1;
+    data.TotalVtxCount = list->VtxBuffer.Size;
+    data.TotalIdxCount = list->IdxBuffer.Size;
+#endif
+    ImGui_ImplOpenGL3_RenderDrawData(&data);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    drawn = true;
+    return true;
+}
+
+void LayerCache::composite(ImDrawList* drawList, ImVec2 pos, ImVec2 quadSize) const {
+    // GL rows run bottom-up, so the canvas top is v = 1
+    drawList->AddImage((ImTextureID)(intptr_t)texture, pos, ImVec2(pos.x + quadSize.x, pos.y + quadSize.y),
+                       ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+}
+
+bool LayerCache::resize(int width, int height) {
+    if (texture && width == textureWidth && height == textureHeight) return true;
+    destroy();
+
+    GLint previousTexture = 0;
+    GLint previousFbo = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    // Drawn 1:1 with the framebuffer, so nearest keeps the edges exact
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+    glBindTexture(GL_TEXTURE_2D, (GLuint)previousTexture);
+
+    if (!complete) {
+        destroy();
+        return false;
+    }
+    textureWidth = width;
+    textureHeight = height;
+    return true;
+}
+
+void LayerCache::destroy() {
+    if (fbo) glDeleteFramebuffers(1, &fbo);
+    if (texture) glDeleteTextures(1, &texture);
+    fbo = texture = 0;
+    textureWidth = textureHeight = 0;
+    drawn = false;
+}
@@ -1,23 +1,29 @@
 #include "../include/ArcaneMath.h"
+#include "../include/ArcaneSolvers.h"
 #include <cmath>
 #include <iostream>
 
-const float PI = 3.14159265358979323846f;
+template <typename T>
+const T PI = T(3.14159265358979323846L);
 
 // Convert degrees to radians
-float degreesToRadians(float degrees) {
-    return degrees * PI / 180.0f;
+template <typename T>
+T degreesToRadians(T degrees) {
+    return degrees * PI<T> / T(180);
 }
 
 // Convert radians to degrees
-float radiansToDegrees(float radians) {
-    return radians * 180.0f / PI;
+template <typename T>
+T radiansToDegrees(T radians) {
+    return radians * T(180) / PI<T>;
 }
 
-ArcaneMath::ArcaneMath(float data[8], bool known[8]) {
+template <typename T>
+ArcaneMath<T>::ArcaneMath(T data[8], bool known[8]) {
     // initialize members to safe defaults
-    gravity = yi = yf = vi = vf = d = theta = time = 0.0f;
+    gravity = yi = yf = vi = vf = d = theta = time = T(0);
     gravityKnown = yiKnown = yfKnown = viKnown = vfKnown = dKnown = thetaKnown = timeKnown = false;
+    iterations = 0;
 
     // Copy provided inputs (guarded)
     if (known != nullptr && data != nullptr) {
@@ -32,7 +38,7 @@ ArcaneMath::ArcaneMath(float data[8], bool known[8]) {
     }
 
     // Validate known flags correspond to finite data; if not, clear the flag and warn
-    auto validate = [&](const char *name, float value, bool &flag) {
+    auto validate = [&](const char *name, T value, bool &flag) {
         if (flag && !std::isfinite(value)) {
             std::cerr << "Warning: input '" << name << "' marked known but value is not finite. Ignoring.\n";
             flag = false;
@@ -50,11 +56,11 @@ ArcaneMath::ArcaneMath(float data[8], bool known[8]) {
 
     // Set default gravity and initial y if both are unknown
     if (!gravityKnown){
-        gravity = 9.8f;
+        gravity = T(9.8);
         gravityKnown = true;
-    } 
+    }
     if(!yiKnown) {
-        yi = 0.0f;
+        yi = T(0);
         yiKnown = true;
     }
 
@@ -64,173 +70,103 @@ ArcaneMath::ArcaneMath(float data[8], bool known[8]) {
     }
 }
 
-void ArcaneMath::solve() {
-    const float EPS = 1e-6f;
-    bool updated;
-    int iterations = 0;
-    const int MAX_ITERATIONS = 100;
-
+template <typename T>
+void ArcaneMath<T>::solve() {
     // theta conversion is handled in the constructor; nothing to do here
+    SolveState<T> s = {
+        gravity, yi, yf, vi, vf, d, theta, time,
+        gravityKnown, yiKnown, yfKnown, viKnown, vfKnown, dKnown, thetaKnown, timeKnown,
+        T(0), T(0)
+    };
+    iterations = solveSpecialized(s);
 
-    do {
-        updated = false;
-        iterations++;
-
-        // --- Horizontal motion ---
-
-        // Solve time from horizontal motion: d = vi * cos(theta) * t
-        if (!timeKnown && dKnown && viKnown && thetaKnown) {
-            float cosTheta = std::cos(theta);
-            if (std::abs(cosTheta) > EPS) {
-                time = d / (vi * cosTheta);
-                timeKnown = true;
-                updated = true;
-            }
-        }
-
-        // Solve horizontal distance: d = vi * cos(theta) * t
-        if (!dKnown && viKnown && thetaKnown && timeKnown) {
-            d = vi * std::cos(theta) * time;
-            dKnown = true;
-            updated = true;
-        }
-
-        // Solve initial velocity from horizontal motion: vi = d / (cos(theta) * t)
-        if (!viKnown && dKnown && thetaKnown && timeKnown) {
-            float cosTheta = std::cos(theta);
-            if (std::abs(cosTheta) > EPS && std::abs(time) > EPS) {
-                vi = d / (cosTheta * time);
-                viKnown = true;
-                updated = true;
-            }
-        }
-
-        // Solve launch angle from horizontal motion: theta = acos(d / (vi * t))
-        if (!thetaKnown && dKnown && viKnown && timeKnown) {
-            float denom = vi * time;
-            if (std::abs(denom) > EPS) {
-                float cosTheta = d / denom;
-                if (cosTheta >= -1.0f && cosTheta <= 1.0f) {
-                    theta = std::acos(cosTheta);
-                    thetaKnown = true;
-                    updated = true;
-                }
-            }
-        }
-
-        // --- Vertical motion ---
-
-        // Assume yi = 0 if not known (projectile starts at ground level)
-        if (!yiKnown && !yfKnown && viKnown && timeKnown && gravityKnown && thetaKnown) {
-            yi = 0.0f;
-            yiKnown = true;
-            updated = true;
-        }
-
-        // Solve final vertical position: yf = yi + vi*sin(theta)*t - 0.5*g*t^2
-        if (!yfKnown && yiKnown && viKnown && timeKnown && gravityKnown && thetaKnown) {
-            yf = yi + vi * std::sin(theta) * time - 0.5f * gravity * time * time;
-            yfKnown = true;
-            updated = true;
-        }
+    gravity = s.gravity; yi = s.yi; yf = s.yf; vi = s.vi;
+    vf = s.vf; d = s.d; theta = s.theta; time = s.time;
+    gravityKnown = s.gravityKnown; yiKnown = s.yiKnown; yfKnown = s.yfKnown; viKnown = s.viKnown;
+    vfKnown = s.vfKnown; dKnown = s.dKnown; thetaKnown = s.thetaKnown; timeKnown = s.timeKnown;
 
-        // If final y position reaches ground (yf = 0) after traveling distance, projectile has landed
-        if (yfKnown && yf <= 0.0f && yf != yi && dKnown && d > EPS) {
-            yf = 0.0f;
-            // Stop further iterations to represent landing
-            updated = false;
-        }
+    // Convert theta back to degrees for output
+    if (thetaKnown) {
+        theta = radiansToDegrees(theta);
+    }
+}
 
-        // Solve initial vertical position: yi = yf - vi*sin(theta)*t + 0.5*g*t^2
-        if (!yiKnown && yfKnown && viKnown && timeKnown && gravityKnown && thetaKnown) {
-            yi = yf - vi * std::sin(theta) * time + 0.5f * gravity * time * time;
-            yiKnown = true;
-            updated = true;
+template <typename T>
+void ArcaneMath<T>::solveBatch(const ArcaneBatch<T>& batch) {
+    if (!batch.gravity || !batch.yi || !batch.yf || !batch.vi || !batch.vf ||
+        !batch.d || !batch.theta || !batch.time || !batch.known) return;
+
+    for (size_t i = 0; i < batch.count; ++i) {
+        unsigned mask = batch.known[i];
+        SolveState<T> s = {
+            batch.gravity[i], batch.yi[i], batch.yf[i], batch.vi[i],
+            batch.vf[i], batch.d[i], batch.theta[i], batch.time[i],
+            (mask & KNOWN_GRAVITY) != 0, (mask & KNOWN_YI) != 0, (mask & KNOWN_YF) != 0,
+            (mask & KNOWN_VI) != 0, (mask & KNOWN_VF) != 0, (mask & KNOWN_D) != 0,
+            (mask & KNOWN_THETA) != 0, (mask & KNOWN_TIME) != 0,
+            T(0), T(0)
+        };
+
+        // Same input rules as the constructor, minus the per-row warnings:
+        // non-finite known values are dropped, gravity and yi get defaults.
+        bool* flags[8] = { &s.gravityKnown, &s.yiKnown, &s.yfKnown, &s.viKnown,
+                           &s.vfKnown, &s.dKnown, &s.thetaKnown, &s.timeKnown };
+        const T values[8] = { s.gravity, s.yi, s.yf, s.vi, s.vf, s.d, s.theta, s.time };
+        for (int k = 0; k < 8; ++k) {
+            if (*flags[k] && !std::isfinite(values[k])) *flags[k] = false;
         }
+        if (!s.gravityKnown) { s.gravity = T(9.8); s.gravityKnown = true; }
+        if (!s.yiKnown)      { s.yi = T(0);      s.yiKnown = true; }
+        if (s.thetaKnown)    s.theta = degreesToRadians(s.theta);
 
-        // Solve initial velocity from vertical motion: vi = (yf - yi + 0.5*g*t^2) / (sin(theta)*t)
-        if (!viKnown && yiKnown && yfKnown && timeKnown && gravityKnown && thetaKnown) {
-            float sinTheta = std::sin(theta);
-            if (std::abs(sinTheta) > EPS && std::abs(time) > EPS) {
-                vi = (yf - yi + 0.5f * gravity * time * time) / (sinTheta * time);
-                viKnown = true;
-                updated = true;
-            }
-        }
+        solveSpecialized(s);
 
-        // Solve launch angle from vertical motion: theta = asin((yf - yi + 0.5*g*t^2) / (vi*t))
-        if (!thetaKnown && yiKnown && yfKnown && viKnown && timeKnown && gravityKnown) {
-            float denom = vi * time;
-            if (std::abs(denom) > EPS) {
-                float sinTheta = (yf - yi + 0.5f * gravity * time * time) / denom;
-                if (sinTheta >= -1.0f && sinTheta <= 1.0f) {
-                    theta = std::asin(sinTheta);
-                    thetaKnown = true;
-                    updated = true;
-                }
-            }
-        }
+        batch.gravity[i] = s.gravity; batch.yi[i] = s.yi; batch.yf[i] = s.yf;
+        batch.vi[i] = s.vi; batch.vf[i] = s.vf; batch.d[i] = s.d;
+        batch.theta[i] = s.thetaKnown ? radiansToDegrees(s.theta) : s.theta;
+        batch.time[i] = s.time;
+        batch.known[i] = (unsigned char)s.knownMask();
+    }
+}
+template <typename T>
+bool ArcaneMath<T>::isSolvable(unsigned knownMask) {
+    return isMaskSolvable(knownMask | KNOWN_GRAVITY | KNOWN_YI);
+}
 
-        // Solve time from vertical motion (quadratic): yf = yi + vi*sin(theta)*t - 0.5*g*t^2
-        if (!timeKnown && yiKnown && yfKnown && viKnown && gravityKnown && thetaKnown) {
-            float a = -0.5f * gravity;
-            float b = vi * std::sin(theta);
-            float c = yi - yf;
-
-            float disc = b*b - 4*a*c;
-            if (disc >= 0 && std::abs(a) > EPS) {
-                float t1 = (-b + std::sqrt(disc)) / (2*a);
-                float t2 = (-b - std::sqrt(disc)) / (2*a);
-                time = (t1 > EPS) ? t1 : t2;
-                timeKnown = true;
-                updated = true;
-            }
-        }
 
-        // Special case: if final height unknown, solve for landing time by setting yf = 0 (ground)
-        if (!timeKnown && yiKnown && !yfKnown && viKnown && gravityKnown && thetaKnown) {
-            // Solve: 0 = yi + vi*sin(theta)*t - 0.5*g*t^2
-            // Rearrange: 0.5*g*t^2 - vi*sin(theta)*t - yi = 0
-            float a = 0.5f * gravity;
-            float b = -vi * std::sin(theta);
-            float c = -yi;
-
-            float disc = b*b - 4*a*c;
-            if (disc >= 0 && std::abs(a) > EPS) {
-                float t1 = (-b + std::sqrt(disc)) / (2*a);
-                float t2 = (-b - std::sqrt(disc)) / (2*a);
-                // Take the positive root (the landing time)
-                time = (t1 > EPS) ? t1 : t2;
-                if (time > EPS) {
-                    timeKnown = true;
-                    yfKnown = false; // Allow yf to be computed next iteration as 0
-                    updated = true;
-                }
-            }
-        }
+template <typename T>
+void ArcaneMath<T>::printPlan(unsigned knownMask) {
+    static const char* const NAMES[8] = { "gravity", "yi", "yf", "vi", "vf", "d", "theta", "time" };
 
-        // --- Final velocity magnitude ---
+    // Plans are keyed on the mask after the constructor's gravity/yi defaults
+    const unsigned effective = (knownMask | KNOWN_GRAVITY | KNOWN_YI) & 0xFF;
+    const SolvePlan& plan = solvePlan(effective);
 
-        // Solve final velocity magnitude: vf = sqrt(vx^2 + vy^2)
-        if (!vfKnown && viKnown && gravityKnown && timeKnown && thetaKnown) {
-            float vx = vi * std::cos(theta);          // horizontal velocity (constant)
-            float vy = vi * std::sin(theta) - gravity * time; // vertical velocity
-            vf = std::sqrt(vx*vx + vy*vy);
-            vfKnown = true;
-            updated = true;
+    std::cout << "plan for known-mask 0x" << std::hex << (knownMask & 0xFF) << std::dec
+              << (isMaskSolvable(effective) ? "" : " (not fully solvable)")
+              << ", " << plan.iterations << " iterations" << std::endl;
+    for (int i = 0; i < plan.count; i++) {
+        const SolveStep& step = plan.steps[i];
+        std::cout << "  [" << (int)step.iteration << "] " << SOLVE_EQUATIONS[step.rule].name
+                  << (step.terminal ? " (ends solve if it triggers)" : "") << std::endl;
+    }
+    for (int v = 0; v < 8; v++) {
+        std::cout << "  " << NAMES[v] << " <- ";
+        if (plan.producer[v] == PRODUCER_INPUT) {
+            std::cout << ((knownMask & (1u << v)) ? "input" : "default");
+        } else if (plan.producer[v] == PRODUCER_UNSOLVED) {
+            std::cout << "unsolved";
+        } else {
+            std::cout << SOLVE_EQUATIONS[plan.producer[v]].name;
         }
-
-    } while(updated && iterations < MAX_ITERATIONS);
-
-    // Convert theta back to degrees for output
-    if (thetaKnown) {
-        theta = radiansToDegrees(theta);
+        std::cout << std::endl;
     }
 }
 
 
 
-void ArcaneMath::print() {
+template <typename T>
+void ArcaneMath<T>::print() {
         std::cout << "g = " << gravity << ", yi = " << yi << ", yf = " << yf
                   << ", vi = " << vi << ", vf = " << vf << ", d = " << d
                   << ", theta = " << theta << ", t = " << time << std::endl;
@@ -238,7 +174,8 @@ void ArcaneMath::print() {
 
 // Copy the internal values into the provided array in the same ordering
 // used by the constructor: gravity, yi, yf, vi, vf, d, theta, time.
-void ArcaneMath::writeToArray(float data[8]) {
+template <typename T>
+void ArcaneMath<T>::writeToArray(T data[8]) {
     if (!data) return;
     data[0] = gravity;
     data[1] = yi;
@@ -248,4 +185,22 @@ void ArcaneMath::writeToArray(float data[8]) {
     data[5] = d;
     data[6] = theta;
     data[7] = time;
-}
\ No newline at end of file
+}
+
+template <typename T>
+unsigned ArcaneMath<T>::getKnownMask() const {
+    unsigned mask = 0;
+    if (gravityKnown) mask |= KNOWN_GRAVITY;
+    if (yiKnown)      mask |= KNOWN_YI;
+    if (yfKnown)      mask |= KNOWN_YF;
+    if (viKnown)      mask |= KNOWN_VI;
+    if (vfKnown)      mask |= KNOWN_VF;
+    if (dKnown)       mask |= KNOWN_D;
+    if (thetaKnown)   mask |= KNOWN_THETA;
+    if (timeKnown)    mask |= KNOWN_TIME;
+    return mask;
+}
+
+template class ArcaneMath<float>;
+template class ArcaneMath<double>;
+template class ArcaneMath<long double>;
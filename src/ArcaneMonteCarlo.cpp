@@ -0,0 +1,406 @@
+#include "../include/ArcaneMonteCarlo.h"
+#include "../include/ArcaneIO.h"
+#include "../include/ArcaneMath.h"
+#include "../include/ArcaneProfiler.h"
+#include "../include/ArcaneScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const size_t CHUNK = 4096;       // samples per solveBatch call / work item
+const size_t PILOT = 4096;       // samples used to size the histograms
+const size_t STATION_BINS = 256;
+
+inline void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+    uint64_t product = (uint64_t)a * b;
+    hi = (uint32_t)(product >> 32);
+    lo = (uint32_t)product;
+}
+
+// Uniform in (0, 1), never exactly 0 or 1
+inline double toUnit(uint32_t bits) {
+    return ((double)bits + 0.5) * (1.0 / 4294967296.0);
+}
+
+// Inputs of one sample: each distribution gets its own pair of uniforms
+struct Draw {
+    double vi, theta, h0, g;
+};
+
+Draw drawSample(const MonteCarloConfig& config, const Philox4x32& rng, uint64_t index) {
+    uint32_t counter[4] = { (uint32_t)index, (uint32_t)(index >> 32), 0, 0 };
+    uint32_t first[4], second[4];
+    rng.generate(counter, first);
+    counter[2] = 1;
+    rng.generate(counter, second);
+
+    Draw d;
+    d.vi = config.vi.sample(toUnit(first[0]), toUnit(first[1]));
+    d.theta = config.theta.sample(toUnit(first[2]), toUnit(first[3]));
+    d.h0 = config.h0.sample(toUnit(second[0]), toUnit(second[1]));
+    d.g = config.gravity.sample(toUnit(second[2]), toUnit(second[3]));
+    return d;
+}
+
+// Vacuum height at horizontal distance x for launch velocity (vx, vy); 0 once
+// the sample has landed
+inline double heightAt(const Draw& s, double vx, double vy, double range, double x) {
+    if (x > range || vx <= 0.0) return 0.0;
+    double t = x / vx;
+    return s.h0 + vy * t - 0.5 * s.g * t * t;
+}
+
+// Per-thread partial results; the histograms share ranges so they merge exactly
+struct Accumulator {
+    StreamingHistogram distance;
+    StreamingHistogram time;
+    std::vector<StreamingHistogram> stations;
+    size_t unsolved = 0;
+};
+
+// Chunk scratch in the layout solveBatch wants
+struct ChunkBuffers {
+    std::vector<double> columns[8];
+    std::vector<unsigned char> known;
+    std::vector<Draw> draws;
+
+    ChunkBuffers() {
+        for (auto& column : columns) column.resize(CHUNK);
+        known.resize(CHUNK);
+        draws.resize(CHUNK);
+    }
+};
+
+// Solve samples [begin, end) and hand each landed one to visit(draw, distance, time)
+template <typename Visit>
+size_t solveChunk(const MonteCarloConfig& config, const Philox4x32& rng,
+                  size_t begin, size_t end, ChunkBuffers& buffers, Visit visit) {
+    const size_t n = end - begin;
+    for (size_t i = 0; i < n; i++) {
+        Draw d = drawSample(config, rng, begin + i);
+        buffers.draws[i] = d;
+        buffers.columns[0][i] = d.g;
+        buffers.columns[1][i] = d.h0;
+        buffers.columns[2][i] = 0.0;
+        buffers.columns[3][i] = d.vi;
+        buffers.columns[4][i] = 0.0;
+        buffers.columns[5][i] = 0.0;
+        buffers.columns[6][i] = d.theta;
+        buffers.columns[7][i] = 0.0;
+        buffers.known[i] = KNOWN_GRAVITY | KNOWN_YI | KNOWN_VI | KNOWN_THETA;
+    }
+
+    ArcaneBatch<double> batch;
+    batch.gravity = buffers.columns[0].data();
+    batch.yi = buffers.columns[1].data();
+    batch.yf = buffers.columns[2].data();
+    batch.vi = buffers.columns[3].data();
+    batch.vf = buffers.columns[4].data();
+    batch.d = buffers.columns[5].data();
+    batch.theta = buffers.columns[6].data();
+    batch.time = buffers.columns[7].data();
+    batch.known = buffers.known.data();
+    batch.count = n;
+    ArcaneMath<double>::solveBatch(batch);
+
+    size_t unsolved = 0;
+    for (size_t i = 0; i < n; i++) {
+        const unsigned landed = KNOWN_D | KNOWN_TIME;
+        double distance = buffers.columns[5][i], time = buffers.columns[7][i];
+        if ((buffers.known[i] & landed) != landed || !std::isfinite(distance) || !std::isfinite(time)) {
+            unsolved++;
+            continue;
+        }
+        visit(buffers.draws[i], distance, time);
+    }
+    return unsolved;
+}
+
+// Histogram range around pilot observations, padded so most samples land inside
+void paddedRange(double lo, double hi, double& outLo, double& outHi) {
+    double span = hi - lo;
+    double pad = std::max(span * 0.25, std::max(std::abs(hi), 1.0) * 1e-3);
+    outLo = lo - pad;
+    outHi = hi + pad;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Philox4x32 / InputDistribution
+// ---------------------------------------------------------------------------
+
+void Philox4x32::generate(const uint32_t counter[4], uint32_t out[4]) const {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(0xD2511F53u, c0, hi0, lo0);
+        mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+InputDistribution InputDistribution::fixed(double value) {
+    InputDistribution d;
+    d.kind = Fixed;
+    d.a = value;
+    return d;
+}
+
+InputDistribution InputDistribution::normal(double mean, double stddev) {
+    InputDistribution d;
+    d.kind = Normal;
+    d.a = mean;
+    d.b = stddev;
+    return d;
+}
+
+InputDistribution InputDistribution::uniform(double lo, double hi) {
+    InputDistribution d;
+    d.kind = Uniform;
+    d.a = lo;
+    d.b = hi;
+    return d;
+}
+
+bool InputDistribution::loadEmpirical(const char* path) {
+    ArcaneLineReader reader;
+    if (!reader.open(path)) return false;
+
+    std::vector<double> loaded;
+    const char* begin;
+    const char* end;
+    while (reader.next(begin, end)) {
+        while (begin < end) {
+            const char* nl = static_cast<const char*>(std::memchr(begin, '\n', (size_t)(end - begin)));
+            const char* lineEnd = nl ? nl : end;
+            const char* p = begin;
+            while (p < lineEnd && (*p == ' ' || *p == '\t')) p++;
+            double value;
+            if (p < lineEnd && *p != '#' && parseNumber(p, lineEnd, value) && std::isfinite(value)) {
+                loaded.push_back(value);
+            }
+            begin = nl ? nl + 1 : end;
+        }
+    }
+    if (loaded.empty()) return false;
+
+    std::sort(loaded.begin(), loaded.end());
+    values.swap(loaded);
+    kind = Empirical;
+    return true;
+}
+
+double InputDistribution::sample(double u1, double u2) const {
+    switch (kind) {
+        case Normal:
+            // Box-Muller, one of the pair
+            return a + b * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2);
+        case Uniform:
+            return a + (b - a) * u1;
+        case Empirical: {
+            if (values.empty()) return a;
+            // Inverse of the piecewise-linear empirical CDF
+            double position = u1 * (double)(values.size() - 1);
+            size_t i = (size_t)position;
+            if (i + 1 >= values.size()) return values.back();
+            double f = position - (double)i;
+            return values[i] + (values[i + 1] - values[i]) * f;
+        }
+        case Fixed:
+        default:
+            return a;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// StreamingHistogram
+// ---------------------------------------------------------------------------
+
+StreamingHistogram::StreamingHistogram(double lo, double hi, size_t binCount)
+    : lo(lo), hi(hi > lo ? hi : lo + 1.0),
+      counts(binCount > 0 ? binCount : 1, 0),
+      minValue(std::numeric_limits<double>::infinity()),
+      maxValue(-std::numeric_limits<double>::infinity()) {
+    binWidth = (this->hi - this->lo) / (double)counts.size();
+}
+
+void StreamingHistogram::add(double value) {
+    if (value < lo) {
+        underflow++;
+    } else if (value >= hi) {
+        overflow++;
+    } else {
+        size_t bin = (size_t)((value - lo) / binWidth);
+        counts[std::min(bin, counts.size() - 1)]++;
+    }
+    total++;
+    double delta = value - runningMean;
+    runningMean += delta / (double)total;
+    m2 += delta * (value - runningMean);
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+}
+
+void StreamingHistogram::merge(const StreamingHistogram& other) {
+    if (other.total == 0) return;
+    for (size_t i = 0; i < counts.size() && i < other.counts.size(); i++) counts[i] += other.counts[i];
+    underflow += other.underflow;
+    overflow += other.overflow;
+
+    // Chan et al. pairwise update of the mean and squared deviations
+    uint64_t combined = total + other.total;
+    double delta = other.runningMean - runningMean;
+    runningMean += delta * (double)other.total / (double)combined;
+    m2 += other.m2 + delta * delta * (double)total * (double)other.total / (double)combined;
+    total = combined;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+double StreamingHistogram::stddev() const {
+    return total > 1 ? std::sqrt(m2 / (double)(total - 1)) : 0.0;
+}
+
+double StreamingHistogram::quantile(double q) const {
+    if (total == 0) return std::numeric_limits<double>::quiet_NaN();
+    q = std::min(std::max(q, 0.0), 1.0);
+    double target = q * (double)total;
+
+    if (target <= (double)underflow) {
+        double f = underflow > 0 ? target / (double)underflow : 0.0;
+        return minValue + (std::min(lo, maxValue) - minValue) * f;
+    }
+    double seen = (double)underflow;
+    for (size_t i = 0; i < counts.size(); i++) {
+        double c = (double)counts[i];
+        if (c > 0.0 && seen + c >= target) {
+            double binLo = lo + binWidth * (double)i;
+            double value = binLo + binWidth * (target - seen) / c;
+            return std::min(std::max(value, minValue), maxValue);
+        }
+        seen += c;
+    }
+    double f = overflow > 0 ? (target - seen) / (double)overflow : 1.0;
+    double start = std::max(hi, minValue);
+    return start + (maxValue - start) * std::min(std::max(f, 0.0), 1.0);
+}
+
+// ---------------------------------------------------------------------------
+// runMonteCarlo
+// ---------------------------------------------------------------------------
+
+MonteCarloResult runMonteCarlo(const MonteCarloConfig& config) {
+    auto start = std::chrono::steady_clock::now();
+    const Philox4x32 rng(config.seed);
+    const size_t samples = config.samples;
+    const size_t stations = std::max<size_t>(config.bandStations, 2);
+
+    // Pilot pass over the first samples to pick histogram ranges
+    double dMin = std::numeric_limits<double>::infinity(), dMax = -dMin;
+    double tMin = dMin, tMax = -dMin;
+    double yLowest = 0.0, yHighest = 0.0;
+    {
+        ChunkBuffers buffers;
+        solveChunk(config, rng, 0, std::min(samples, PILOT), buffers, [&](const Draw& d, double distance, double time) {
+            dMin = std::min(dMin, distance); dMax = std::max(dMax, distance);
+            tMin = std::min(tMin, time); tMax = std::max(tMax, time);
+            double vy = d.vi * std::sin(d.theta * PI / 180.0);
+            double apex = d.h0 + (vy > 0.0 ? vy * vy / (2.0 * d.g) : 0.0);
+            yLowest = std::min(yLowest, d.h0);
+            yHighest = std::max(yHighest, apex);
+        });
+    }
+    if (!(dMax >= dMin)) { dMin = 0.0; dMax = 1.0; tMin = 0.0; tMax = 1.0; }
+
+    double dLo, dHi, tLo, tHi, yLo, yHi;
+    paddedRange(dMin, dMax, dLo, dHi);
+    paddedRange(tMin, tMax, tLo, tHi);
+    paddedRange(yLowest, yHighest, yLo, yHi);
+    const double bandEnd = std::max(dMax * 1.05, 1e-3);
+
+    MonteCarloResult result;
+    result.distance = StreamingHistogram(dLo, dHi, config.histogramBins);
+    result.time = StreamingHistogram(tLo, tHi, config.histogramBins);
+    result.bandX.resize(stations);
+    for (size_t k = 0; k < stations; k++) result.bandX[k] = (float)(bandEnd * (double)k / (double)(stations - 1));
+
+    std::unique_ptr<TaskScheduler> ownScheduler;
+    TaskScheduler& scheduler = TaskScheduler::select(config.threads, ownScheduler);
+    const size_t chunks = (samples + CHUNK - 1) / CHUNK;
+
+    // One accumulator per worker (and one for the calling thread), so chunks
+    // add to them without locks
+    const size_t slots = scheduler.workerCount() + 1;
+    std::vector<Accumulator> partial(slots);
+    for (Accumulator& acc : partial) {
+        acc.distance = result.distance;
+        acc.time = result.time;
+        acc.stations.assign(stations, StreamingHistogram(yLo, yHi, STATION_BINS));
+    }
+    std::vector<std::unique_ptr<ChunkBuffers>> buffers(slots);
+
+    std::atomic<size_t> drawn{0};
+    TaskGroup group(scheduler);
+    scheduler.parallelFor(group, 0, chunks, [&](size_t firstChunk, size_t lastChunk) {
+        const unsigned slot = scheduler.currentWorker();
+        Accumulator& acc = partial[slot];
+        if (!buffers[slot]) buffers[slot].reset(new ChunkBuffers());
+        for (size_t chunk = firstChunk; chunk < lastChunk && !group.cancelled(); chunk++) {
+            size_t begin = chunk * CHUNK;
+            size_t end = std::min(begin + CHUNK, samples);
+            ARCANE_PROFILE_SCOPE("Monte Carlo chunk");
+            acc.unsolved += solveChunk(config, rng, begin, end, *buffers[slot], [&](const Draw& d, double distance, double time) {
+                acc.distance.add(distance);
+                acc.time.add(time);
+                double vx = d.vi * std::cos(d.theta * PI / 180.0);
+                double vy = d.vi * std::sin(d.theta * PI / 180.0);
+                for (size_t k = 0; k < stations; k++) {
+                    acc.stations[k].add(heightAt(d, vx, vy, distance, result.bandX[k]));
+                }
+            });
+            size_t done = drawn.fetch_add(end - begin) + (end - begin);
+            if (config.onProgress && !config.onProgress(done, samples)) group.cancel();
+        }
+    });
+    group.wait();
+    result.samples = drawn;
+    result.cancelled = group.cancelled();
+
+    // Merge in worker order; bin counts (and so every quantile) do not depend
+    // on the thread count or on which worker ran which chunk, the mean and
+    // stddev only up to rounding
+    std::vector<StreamingHistogram> stationTotals(stations, StreamingHistogram(yLo, yHi, STATION_BINS));
+    for (const Accumulator& acc : partial) {
+        result.distance.merge(acc.distance);
+        result.time.merge(acc.time);
+        result.unsolved += acc.unsolved;
+        for (size_t k = 0; k < stations; k++) stationTotals[k].merge(acc.stations[k]);
+    }
+
+    result.bandLow.resize(stations);
+    result.bandMid.resize(stations);
+    result.bandHigh.resize(stations);
+    for (size_t k = 0; k < stations; k++) {
+        result.bandLow[k] = (float)stationTotals[k].quantile(config.bandQuantiles[0]);
+        result.bandMid[k] = (float)stationTotals[k].quantile(config.bandQuantiles[1]);
+        result.bandHigh[k] = (float)stationTotals[k].quantile(config.bandQuantiles[2]);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
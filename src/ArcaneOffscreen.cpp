@@ -0,0 +1,88 @@
+#include "../include/ArcaneOffscreen.h"
+#include <cstring>
+
+OffscreenTarget::~OffscreenTarget() {
+    destroy();
+}
+
+bool OffscreenTarget::create(int width, int height) {
+    destroy();
+    w = width;
+    h = height;
+
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &color);
+    glBindRenderbuffer(GL_RENDERBUFFER, color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glGenBuffers(2, pbo);
+    for (GLuint buffer : pbo) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)w * h * 4, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!complete) destroy();
+    return complete;
+}
+
+void OffscreenTarget::destroy() {
+    if (pbo[0]) glDeleteBuffers(2, pbo);
+    if (color) glDeleteRenderbuffers(1, &color);
+    if (fbo) glDeleteFramebuffers(1, &fbo);
+    fbo = color = pbo[0] = pbo[1] = 0;
+    pending[0] = pending[1] = false;
+    next = 0;
+}
+
+void OffscreenTarget::bind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, w, h);
+}
+
+void OffscreenTarget::unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool OffscreenTarget::copyOut(int buffer, std::vector<uint8_t>& out, int& outTag) {
+    if (!pending[buffer]) return false;
+    pending[buffer] = false;
+
+    const size_t bytes = (size_t)w * h * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[buffer]);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_READ_BIT);
+    bool ok = pixels != nullptr;
+    if (ok) {
+        out.resize(bytes);
+        std::memcpy(out.data(), pixels, bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        outTag = tags[buffer];
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return ok;
+}
+
+bool OffscreenTarget::capture(int tag, std::vector<uint8_t>& out, int& outTag) {
+    // Start this frame's transfer first so the GPU has it queued while the
+    // previous one is mapped
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[next]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pending[next] = true;
+    tags[next] = tag;
+
+    next ^= 1;
+    return copyOut(next, out, outTag);
+}
+
+bool OffscreenTarget::drain(std::vector<uint8_t>& out, int& outTag) {
+    // The older capture is the one capture() would copy next
+    if (copyOut(next, out, outTag)) return true;
+    return copyOut(next ^ 1, out, outTag);
+}
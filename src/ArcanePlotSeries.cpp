@@ -0,0 +1,208 @@
+#include "../include/ArcanePlotSeries.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Below this many visible points per pixel the raw points are drawn as they are
+const size_t POINTS_PER_PIXEL = 2;
+
+// Append the indices of the lowest and highest y in [first, last), in index order
+void scanExtremes(const std::vector<float>& y, size_t first, size_t last, std::vector<uint32_t>& picked) {
+    if (first >= last) return;
+    size_t lo = first, hi = first;
+    for (size_t i = first + 1; i < last; ++i) {
+        if (y[i] < y[lo]) lo = i;
+        if (y[i] > y[hi]) hi = i;
+    }
+    picked.push_back((uint32_t)std::min(lo, hi));
+    if (lo != hi) picked.push_back((uint32_t)std::max(lo, hi));
+}
+
+} // namespace
+
+void PlotSeries::clear() {
+    xs.clear();
+    ys.clear();
+    levels.clear();
+    xSorted = true;
+    xLo = xHi = yLo = yHi = 0.0f;
+    for (CachedView& view : cache) view.lastUsed = 0;
+}
+
+void PlotSeries::assign(const float* x, const float* y, size_t count) {
+    clear();
+    xs.assign(x, x + count);
+    ys.assign(y, y + count);
+    if (count == 0) return;
+
+    xLo = xHi = xs[0];
+    yLo = yHi = ys[0];
+    for (size_t i = 1; i < count; ++i) {
+        if (xs[i] < xs[i - 1]) xSorted = false;
+        xLo = std::min(xLo, xs[i]);
+        xHi = std::max(xHi, xs[i]);
+        yLo = std::min(yLo, ys[i]);
+        yHi = std::max(yHi, ys[i]);
+    }
+    buildPyramid();
+}
+
+void PlotSeries::buildPyramid() {
+    // Level 0 pairs up raw points, every further level pairs up the blocks below
+    size_t blocks = xs.size() / 2;
+    if (blocks == 0) return;
+    levels.emplace_back(blocks);
+    for (size_t b = 0; b < blocks; ++b) {
+        uint32_t a = (uint32_t)(2 * b), c = a + 1;
+        levels[0][b] = { ys[c] < ys[a] ? c : a, ys[c] > ys[a] ? c : a };
+    }
+    while (levels.back().size() >= 2) {
+        const std::vector<Extremes>& below = levels.back();
+        std::vector<Extremes> level(below.size() / 2);
+        for (size_t b = 0; b < level.size(); ++b) {
+            const Extremes& l = below[2 * b];
+            const Extremes& r = below[2 * b + 1];
+            level[b] = { ys[r.lo] < ys[l.lo] ? r.lo : l.lo, ys[r.hi] > ys[l.hi] ? r.hi : l.hi };
+        }
+        levels.push_back(std::move(level));
+    }
+}
+
+void PlotSeries::visibleRange(double viewMin, double viewMax, size_t& first, size_t& last) const {
+    first = 0;
+    last = xs.size();
+    if (!xSorted) return;
+    // One point past either edge, so the line runs off the plot instead of stopping short
+    size_t lo = (size_t)(std::lower_bound(xs.begin(), xs.end(), (float)viewMin) - xs.begin());
+    size_t hi = (size_t)(std::upper_bound(xs.begin(), xs.end(), (float)viewMax) - xs.begin());
+    first = lo > 0 ? lo - 1 : 0;
+    last = std::min(hi + 1, xs.size());
+    if (first >= last) first = last > 0 ? last - 1 : 0;
+}
+
+void PlotSeries::pickMinMax(size_t first, size_t last, int pixels, std::vector<uint32_t>& picked) const {
+    // Largest block size that still leaves at least one block per pixel
+    const size_t perPixel = (last - first) / (size_t)pixels;
+    size_t level = 0;
+    while (level + 1 < levels.size() && ((size_t)2 << (level + 1)) <= perPixel) level++;
+    const size_t blockSize = (size_t)2 << level;
+
+    picked.push_back((uint32_t)first);
+    if (levels.empty() || perPixel < 2) {
+        // Too few points for blocks: raw buckets of perPixel points
+        const size_t bucket = std::max<size_t>(perPixel, 1);
+        for (size_t i = first; i < last; i += bucket) scanExtremes(ys, i, std::min(i + bucket, last), picked);
+    } else {
+        size_t firstBlock = (first + blockSize - 1) / blockSize;
+        size_t lastBlock = std::min(last / blockSize, levels[level].size());
+        if (firstBlock >= lastBlock) {
+            scanExtremes(ys, first, last, picked);
+        } else {
+            scanExtremes(ys, first, firstBlock * blockSize, picked);
+            for (size_t b = firstBlock; b < lastBlock; ++b) {
+                const Extremes& e = levels[level][b];
+                picked.push_back(std::min(e.lo, e.hi));
+                if (e.lo != e.hi) picked.push_back(std::max(e.lo, e.hi));
+            }
+            scanExtremes(ys, lastBlock * blockSize, last, picked);
+        }
+    }
+    picked.push_back((uint32_t)(last - 1));
+}
+
+void PlotSeries::pickLTTB(size_t first, size_t last, int pixels, std::vector<uint32_t>& picked) const {
+    // Largest-Triangle-Three-Buckets: keep the endpoints, and from every bucket
+    // between them the point forming the largest triangle with the previously
+    // kept point and the average of the next bucket
+    const size_t n = last - first;
+    const size_t target = std::min(n, (size_t)pixels * POINTS_PER_PIXEL);
+    picked.push_back((uint32_t)first);
+    if (target >= 3) {
+        const double bucket = (double)(n - 2) / (double)(target - 2);
+        size_t kept = first;
+        for (size_t b = 0; b < target - 2; ++b) {
+            size_t start = first + 1 + (size_t)(b * bucket);
+            size_t end = std::min(first + 1 + (size_t)((b + 1) * bucket), last - 1);
+            size_t nextEnd = std::min(first + 1 + (size_t)((b + 2) * bucket), last - 1);
+            double ax = 0.0, ay = 0.0;
+            if (nextEnd > end) {
+                for (size_t i = end; i < nextEnd; ++i) {
+                    ax += xs[i];
+                    ay += ys[i];
+                }
+                ax /= (double)(nextEnd - end);
+                ay /= (double)(nextEnd - end);
+            } else {
+                ax = xs[last - 1];
+                ay = ys[last - 1];
+            }
+
+            const double px = xs[kept], py = ys[kept];
+            double bestArea = -1.0;
+            size_t best = start;
+            for (size_t i = start; i < std::max(end, start + 1); ++i) {
+                double area = std::abs((px - ax) * (ys[i] - py) - (px - xs[i]) * (ay - py));
+                if (area > bestArea) {
+                    bestArea = area;
+                    best = i;
+                }
+            }
+            picked.push_back((uint32_t)best);
+            kept = best;
+        }
+    }
+    if (n > 1) picked.push_back((uint32_t)(last - 1));
+}
+
+PlotView PlotSeries::view(double viewMin, double viewMax, int pixels, Decimation mode) {
+    PlotView view;
+    if (xs.empty()) return view;
+
+    size_t first, last;
+    visibleRange(viewMin, viewMax, first, last);
+    pixels = std::max(pixels, 1);
+    if (mode == Decimation::None || last - first <= (size_t)pixels * POINTS_PER_PIXEL) {
+        view.x = xs.data() + first;
+        view.y = ys.data() + first;
+        view.count = (int)(last - first);
+        return view;
+    }
+
+    // Reuse a cached view of this zoom, or recompute into the least recently used slot
+    CachedView* slot = nullptr;
+    for (CachedView& c : cache) {
+        if (c.lastUsed != 0 && c.viewMin == viewMin && c.viewMax == viewMax && c.pixels == pixels && c.mode == mode) {
+            slot = &c;
+            break;
+        }
+    }
+    if (!slot) {
+        slot = &cache[0];
+        for (CachedView& c : cache) {
+            if (c.lastUsed < slot->lastUsed) slot = &c;
+        }
+        slot->viewMin = viewMin;
+        slot->viewMax = viewMax;
+        slot->pixels = pixels;
+        slot->mode = mode;
+        slot->picked.clear();
+        if (mode == Decimation::MinMax) {
+            pickMinMax(first, last, pixels, slot->picked);
+        } else {
+            pickLTTB(first, last, pixels, slot->picked);
+        }
+        slot->x.resize(slot->picked.size());
+        slot->y.resize(slot->picked.size());
+        for (size_t i = 0; i < slot->picked.size(); ++i) {
+            slot->x[i] = xs[slot->picked[i]];
+            slot->y[i] = ys[slot->picked[i]];
+        }
+    }
+    slot->lastUsed = ++useCounter;
+
+    view.x = slot->x.data();
+    view.y = slot->y.data();
+    view.count = (int)slot->x.size();
+    return view;
+}
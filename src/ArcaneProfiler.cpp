@@ -0,0 +1,174 @@
+#include "../include/ArcaneProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Single-producer ring: the owning thread advances head, endFrame() advances tail
+struct Profiler::ThreadRing {
+    ProfileEvent events[RING_EVENTS];
+    std::atomic<size_t> head{ 0 };
+    std::atomic<size_t> tail{ 0 };
+    std::atomic<bool> inUse{ true };
+    uint32_t id = 0;
+    uint32_t depth = 0;
+};
+
+// Hands the ring back for reuse when its thread exits
+struct Profiler::RingHandle {
+    ThreadRing* ring = nullptr;
+    ~RingHandle() {
+        if (ring) ring->inUse.store(false, std::memory_order_release);
+    }
+};
+
+namespace {
+
+uint64_t steadyNanoseconds() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Events a history frame has room for up front, so steady-state frames
+// drain without growing a vector
+const size_t FRAME_EVENTS_RESERVED = 128;
+
+double quantileOf(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double position = q * (double)(sorted.size() - 1);
+    size_t below = (size_t)position;
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (sorted[above] - sorted[below]) * (position - (double)below);
+}
+
+} // namespace
+
+const size_t Profiler::HISTORY_FRAMES;
+const size_t Profiler::RING_EVENTS;
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : epoch(steadyNanoseconds()), history(HISTORY_FRAMES) {
+    for (ProfileFrame& frame : history) frame.events.reserve(FRAME_EVENTS_RESERVED);
+    discarded.events.reserve(FRAME_EVENTS_RESERVED);
+}
+
+uint64_t Profiler::now() const {
+    return steadyNanoseconds() - epoch;
+}
+
+Profiler::ThreadRing& Profiler::ring() {
+    thread_local RingHandle handle;
+    if (!handle.ring) {
+        std::lock_guard<std::mutex> lock(registry);
+        // Reuse the ring of a finished thread once it has been drained
+        for (std::unique_ptr<ThreadRing>& candidate : rings) {
+            if (!candidate->inUse.load(std::memory_order_acquire) &&
+                candidate->head.load(std::memory_order_acquire) == candidate->tail.load(std::memory_order_acquire)) {
+                candidate->depth = 0;
+                candidate->inUse.store(true, std::memory_order_release);
+                handle.ring = candidate.get();
+                break;
+            }
+        }
+        if (!handle.ring) {
+            rings.emplace_back(new ThreadRing());
+            rings.back()->id = (uint32_t)(rings.size() - 1);
+            handle.ring = rings.back().get();
+        }
+    }
+    return *handle.ring;
+}
+
+void Profiler::enter() {
+    ring().depth++;
+}
+
+void Profiler::leave() {
+    ThreadRing& r = ring();
+    if (r.depth > 0) r.depth--;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end, uint64_t allocations, uint64_t bytes) {
+    ThreadRing& r = ring();
+    size_t head = r.head.load(std::memory_order_relaxed);
+    if (head - r.tail.load(std::memory_order_acquire) >= RING_EVENTS) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    r.events[head % RING_EVENTS] = { name, start, end, r.id, r.depth, (uint32_t)allocations, bytes };
+    r.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::endFrame() {
+    uint64_t end = now();
+    ProfileFrame& frame = paused ? discarded : history[next];
+    frame.start = lastFrameEnd;
+    frame.end = end;
+    frame.events.clear();
+    lastFrameEnd = end;
+    // Counted on the thread that ends frames, before draining adds its own
+    AllocationCount allocations = threadAllocations();
+    frame.allocations.count = allocations.count - lastFrameAllocations.count;
+    frame.allocations.bytes = allocations.bytes - lastFrameAllocations.bytes;
+    lastFrameAllocations = allocations;
+
+    {
+        std::lock_guard<std::mutex> lock(registry);
+        for (std::unique_ptr<ThreadRing>& r : rings) {
+            size_t tail = r->tail.load(std::memory_order_relaxed);
+            size_t head = r->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) frame.events.push_back(r->events[tail % RING_EVENTS]);
+            r->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    if (paused) return;
+    next = (next + 1) % HISTORY_FRAMES;
+    stored = std::min(stored + 1, HISTORY_FRAMES);
+}
+
+const ProfileFrame& Profiler::frame(size_t i) const {
+    return history[(next + HISTORY_FRAMES - stored + i) % HISTORY_FRAMES];
+}
+
+std::vector<ProfileScopeStats> Profiler::scopeStats() const {
+    // Scope names compare by content: the same literal may have several addresses
+    std::vector<const char*> names;
+    std::vector<std::vector<double>> perFrame;
+    std::vector<double> allocationSums;
+    std::vector<double> totals;
+    for (size_t f = 0; f < stored; ++f) {
+        const ProfileFrame& fr = frame(f);
+        totals.assign(names.size(), -1.0);
+        for (const ProfileEvent& event : fr.events) {
+            size_t k = 0;
+            while (k < names.size() && std::strcmp(names[k], event.name) != 0) k++;
+            if (k == names.size()) {
+                names.push_back(event.name);
+                perFrame.emplace_back();
+                allocationSums.push_back(0.0);
+                totals.push_back(-1.0);
+            }
+            totals[k] = std::max(totals[k], 0.0) + (double)(event.end - event.start) * 1e-6;
+            allocationSums[k] += (double)event.allocations;
+        }
+        for (size_t k = 0; k < totals.size(); ++k) {
+            if (totals[k] >= 0.0) perFrame[k].push_back(totals[k]);
+        }
+    }
+
+    std::vector<ProfileScopeStats> stats;
+    for (size_t k = 0; k < names.size(); ++k) {
+        std::vector<double>& ms = perFrame[k];
+        std::sort(ms.begin(), ms.end());
+        double sum = 0.0;
+        for (double value : ms) sum += value;
+        stats.push_back({ names[k], ms.size(), sum / (double)ms.size(),
+                          quantileOf(ms, 0.5), quantileOf(ms, 0.95), quantileOf(ms, 0.99), ms.back(),
+                          allocationSums[k] / (double)ms.size() });
+    }
+    return stats;
+}
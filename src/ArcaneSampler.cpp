@@ -0,0 +1,185 @@
+#include "../include/ArcaneSampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const size_t MIN_DENSE_SAMPLES = 1024;
+
+// Copy sample i of src into slot j of dst, blending toward i + 1 by f
+void copyBlend(const TrajectoryBuffers& src, size_t i, float f, TrajectoryBuffers& dst, size_t j) {
+    size_t k = std::min(i + 1, src.count - 1);
+    auto mix = [&](const std::vector<float>& a) { return a[i] + (a[k] - a[i]) * f; };
+    dst.t[j] = mix(src.t);
+    dst.x[j] = mix(src.x);
+    dst.y[j] = mix(src.y);
+    dst.vx[j] = mix(src.vx);
+    dst.vy[j] = mix(src.vy);
+    dst.speed[j] = mix(src.speed);
+}
+
+} // namespace
+
+void TrajectoryBuffers::reserve(size_t samples) {
+    if (t.size() >= samples) return;
+    for (std::vector<float>* column : { &t, &x, &y, &vx, &vy, &speed }) column->resize(samples);
+}
+
+TrajectorySamples TrajectoryBuffers::columns() {
+    TrajectorySamples samples;
+    samples.t = t.data();
+    samples.x = x.data();
+    samples.y = y.data();
+    samples.vx = vx.data();
+    samples.vy = vy.data();
+    samples.speed = speed.data();
+    return samples;
+}
+
+void TrajectoryBuffers::positionAt(float time, float& outX, float& outY) const {
+    if (count == 0) {
+        outX = outY = 0.0f;
+        return;
+    }
+    if (time <= t[0] || count == 1) {
+        outX = x[0];
+        outY = y[0];
+        return;
+    }
+    if (time >= t[count - 1]) {
+        outX = x[count - 1];
+        outY = y[count - 1];
+        return;
+    }
+    size_t i = (size_t)(std::upper_bound(t.begin(), t.begin() + count, time) - t.begin()) - 1;
+    float span = t[i + 1] - t[i];
+    float f = span > 0.0f ? (time - t[i]) / span : 0.0f;
+    outX = x[i] + (x[i + 1] - x[i]) * f;
+    outY = y[i] + (y[i + 1] - y[i]) * f;
+}
+
+// Time the path reaches y = 0, or maxTime if it does not land before then
+float TrajectorySampler::landingTime(const TrajectorySource& source, bool& landed) {
+    const TrajectoryParams& p = source.params;
+    double tLand = -1.0;
+    lastStats = IntegratorStats();
+    if (source.drag) {
+        IntegratorOptions options = source.integrator;
+        options.maxTime = source.maxTime;
+        lastStats = findImpact(p, options);
+        if (lastStats.landed) tLand = lastStats.impactTime;
+    } else if (p.g > 0.0f) {
+        // Positive root of g/2 t^2 - vy t - h0 = 0, cancellation-free
+        double vy = p.v0 * std::sin((double)p.theta);
+        double disc = vy * vy + 2.0 * p.g * p.h0;
+        if (disc >= 0.0) {
+            double s = std::sqrt(disc);
+            tLand = vy >= 0.0 ? (vy + s) / p.g : 2.0 * p.h0 / (s - vy);
+        }
+    }
+    landed = tLand >= 0.0 && tLand <= source.maxTime;
+    return landed ? (float)tLand : source.maxTime;
+}
+
+void TrajectorySampler::evaluate(const TrajectorySource& source, float endTime, size_t count, TrajectoryBuffers& out) {
+    out.reserve(count);
+    out.count = count;
+    if (count == 0) return;
+    const float dt = count > 1 ? endTime / (float)(count - 1) : 0.0f;
+    if (source.drag) {
+        integrateTrajectory(source.params, source.integrator, 0.0, dt, count, out.columns());
+    } else {
+        sampleTrajectory(source.params, 0.0f, dt, count, out.columns());
+    }
+}
+
+void TrajectorySampler::sample(const TrajectorySource& source, const SamplePolicy& policy, TrajectoryBuffers& out) {
+    bool landed = false;
+    const float endTime = landingTime(source, landed);
+    const size_t count = std::max<size_t>(policy.count, 2);
+
+    if (policy.kind == SamplePolicy::UniformTime) {
+        evaluate(source, endTime, count, out);
+    } else if (policy.kind == SamplePolicy::UniformArcLength) {
+        // Equal steps along the cumulative length of a dense uniform-time pass
+        evaluate(source, endTime, std::max(count * 8, MIN_DENSE_SAMPLES), dense);
+        if (arcLength.size() < dense.count) arcLength.resize(dense.count);
+        arcLength[0] = 0.0;
+        for (size_t i = 1; i < dense.count; i++) {
+            arcLength[i] = arcLength[i - 1] + std::hypot((double)(dense.x[i] - dense.x[i - 1]),
+                                                         (double)(dense.y[i] - dense.y[i - 1]));
+        }
+        const double total = arcLength[dense.count - 1];
+
+        out.reserve(count);
+        out.count = count;
+        size_t seg = 0;
+        for (size_t j = 0; j < count; j++) {
+            double target = total * (double)j / (double)(count - 1);
+            while (seg + 2 < dense.count && arcLength[seg + 1] < target) seg++;
+            double segLength = arcLength[seg + 1] - arcLength[seg];
+            float f = segLength > 0.0 ? (float)std::min(std::max((target - arcLength[seg]) / segLength, 0.0), 1.0) : 0.0f;
+            copyBlend(dense, seg, f, out, j);
+        }
+    } else {
+        // Keep the fewest dense points whose chords stay within the pixel
+        // bound: extend each chord while its direction fits the cone of
+        // directions passing within tol of every point it skips. The cone
+        // cannot see a path that doubles back along the same ray (a vertical
+        // shot), so chords also end at the apex and wherever the points stop
+        // moving forward along the chord.
+        const size_t denseCount = std::max(policy.maxSamples * 4, MIN_DENSE_SAMPLES);
+        evaluate(source, endTime, denseCount, dense);
+        const size_t maxSamples = std::max<size_t>(policy.maxSamples, 2);
+        out.reserve(std::min(denseCount, maxSamples));
+
+        double tol = (double)policy.maxPixelError / std::max((double)policy.pxPerMeter, 1e-6);
+        while (true) {
+            size_t emitted = 0;
+            size_t anchor = 0;
+            auto emit = [&](size_t i) {
+                if (emitted < maxSamples) copyBlend(dense, i, 0.0f, out, emitted);
+                emitted++;
+            };
+            emit(0);
+            while (anchor + 1 < dense.count) {
+                double refX = 0.0, refY = 0.0; // direction the cone angles are measured from
+                double lo = -1e30, hi = 1e30;
+                double reach = 0.0; // furthest projection onto ref so far
+                size_t k = anchor + 1;
+                size_t last = k;
+                for (; k < dense.count; k++) {
+                    double dx = dense.x[k] - dense.x[anchor], dy = dense.y[k] - dense.y[anchor];
+                    double r = std::hypot(dx, dy);
+                    if (r > tol) {
+                        if (refX == 0.0 && refY == 0.0) {
+                            refX = dx / r;
+                            refY = dy / r;
+                        }
+                        double along = refX * dx + refY * dy;
+                        if (along < reach) break; // turning back
+                        double angle = std::atan2(refX * dy - refY * dx, along);
+                        if (angle < lo || angle > hi) break;
+                        double half = std::asin(std::min(tol / r, 1.0));
+                        lo = std::max(lo, angle - half);
+                        hi = std::min(hi, angle + half);
+                        reach = along;
+                    }
+                    last = k;
+                    if (dense.vy[k - 1] > 0.0f && dense.vy[k] <= 0.0f) break; // apex
+                }
+                anchor = last;
+                emit(anchor);
+            }
+            if (emitted <= maxSamples) {
+                out.count = emitted;
+                break;
+            }
+            tol *= 1.5; // too many points for the cap: loosen and retry
+        }
+    }
+
+    if (landed && out.count > 0) out.y[out.count - 1] = 0.0f;
+    out.endTime = out.count > 0 ? out.t[out.count - 1] : 0.0f;
+    out.landed = landed;
+}
@@ -0,0 +1,346 @@
+#include "../include/ArcaneScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace {
+
+// Smallest automatic grain gives about this many pieces per worker, enough
+// for stealing to even out uneven pieces
+const size_t PIECES_PER_WORKER = 16;
+// Owner-side size of a new deque ring; it doubles when full
+const int64_t DEQUE_CAPACITY = 256;
+
+// Single-owner work-stealing deque (Chase-Lev, with the C11 orderings of
+// Le et al. 2013). The owning worker pushes and pops at the bottom, newest
+// first; any thread steals the oldest from the top. Outgrown rings are kept
+// until the deque dies, since a thief may still be reading one.
+template <typename T>
+class StealingDeque {
+    public:
+        StealingDeque() : ring(new Ring(DEQUE_CAPACITY)) {}
+        ~StealingDeque() {
+            delete ring.load(std::memory_order_relaxed);
+            for (Ring* old : retired) delete old;
+        }
+
+        void push(T* item) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            Ring* r = ring.load(std::memory_order_relaxed);
+            if (b - t >= r->capacity) r = grow(r, t, b);
+            r->put(b, item);
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        T* pop() {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Ring* r = ring.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_seq_cst);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            T* item = r->get(b);
+            if (t == b) {
+                // Last item: race the thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        T* steal() {
+            int64_t t = top.load(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_seq_cst);
+            if (t >= b) return nullptr;
+            T* item = ring.load(std::memory_order_acquire)->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+
+        bool empty() const {
+            return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Ring {
+            int64_t capacity; // power of two
+            std::unique_ptr<std::atomic<T*>[]> slots;
+
+            explicit Ring(int64_t capacity) : capacity(capacity), slots(new std::atomic<T*>[(size_t)capacity]) {}
+            T* get(int64_t i) const { return slots[(size_t)(i & (capacity - 1))].load(std::memory_order_relaxed); }
+            void put(int64_t i, T* item) { slots[(size_t)(i & (capacity - 1))].store(item, std::memory_order_relaxed); }
+        };
+
+        Ring* grow(Ring* old, int64_t t, int64_t b) {
+            Ring* bigger = new Ring(old->capacity * 2);
+            for (int64_t i = t; i < b; i++) bigger->put(i, old->get(i));
+            retired.push_back(old);
+            ring.store(bigger, std::memory_order_release);
+            return bigger;
+        }
+
+        std::atomic<int64_t> top{ 0 };
+        std::atomic<int64_t> bottom{ 0 };
+        std::atomic<Ring*> ring;
+        std::vector<Ring*> retired; // owner only
+};
+
+// Which pool, if any, the calling thread works for
+thread_local const TaskScheduler* currentScheduler = nullptr;
+thread_local unsigned currentIndex = 0;
+
+std::mutex sharedMutex;
+SchedulerOptions sharedOptions;
+bool sharedCreated = false;
+
+void pinToCore(std::thread& thread, unsigned core) {
+#if defined(__linux__)
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(core, &cores);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cores), &cores);
+#else
+    (void)thread;
+    (void)core;
+#endif
+}
+
+} // namespace
+
+struct TaskScheduler::Task {
+    std::function<void()> run;
+    TaskGroup* group;
+};
+
+struct TaskScheduler::Worker {
+    StealingDeque<Task> deque;
+    std::thread thread;
+    uint32_t victimSeed; // xorshift state for picking whom to steal from
+};
+
+// One parallelFor call, shared by all of its pieces
+struct TaskScheduler::Range {
+    std::function<void(size_t, size_t)> body;
+    size_t grain;
+    TaskGroup* group;
+};
+
+// ---------------------------------------------------------------------------
+// TaskGroup
+// ---------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler) : owner(scheduler) {}
+
+TaskGroup::TaskGroup() : owner(TaskScheduler::shared()) {}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    owner.spawn(new TaskScheduler::Task{ std::move(task), this });
+}
+
+void TaskGroup::finishOne() {
+    // Under the lock, so a waiter that sees the count reach zero cannot
+    // destroy the group before this returns
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) finished.notify_all();
+}
+
+void TaskGroup::wait() {
+    while (!waitFor(1.0)) {}
+}
+
+bool TaskGroup::waitFor(double seconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    unsigned self = owner.currentWorker();
+    if (self < owner.workerCount()) {
+        // Blocking a worker could leave nobody to run the tasks waited on
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (TaskScheduler::Task* task = owner.findTask(self)) {
+                owner.execute(task);
+            } else if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex); // the last finishOne() has returned
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    return finished.wait_until(lock, deadline, [&]() { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+// ---------------------------------------------------------------------------
+// TaskScheduler
+// ---------------------------------------------------------------------------
+
+TaskScheduler::TaskScheduler(const SchedulerOptions& options) {
+    unsigned count = options.threads > 0 ? options.threads : std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+    const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned i = 0; i < count; i++) {
+        workers.emplace_back(new Worker());
+        workers.back()->victimSeed = 2463534242u + i * 747796405u;
+    }
+    // All deques exist before any worker can try to steal
+    for (unsigned i = 0; i < count; i++) {
+        workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+        if (options.pinThreads) pinToCore(workers[i]->thread, i % cores);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) worker->thread.join();
+    // Leftovers only exist if a group was destroyed without waiting
+    for (Task* task : injected) delete task;
+    for (auto& worker : workers) {
+        while (Task* task = worker->deque.pop()) delete task;
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler* scheduler = []() {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        sharedCreated = true;
+        return new TaskScheduler(sharedOptions); // lives until exit; workers sleep when idle
+    }();
+    return *scheduler;
+}
+
+bool TaskScheduler::configureShared(const SchedulerOptions& options) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedCreated) return false;
+    sharedOptions = options;
+    return true;
+}
+
+TaskScheduler& TaskScheduler::select(unsigned threads, std::unique_ptr<TaskScheduler>& own) {
+    TaskScheduler& pool = shared();
+    if (threads == 0 || threads == pool.workerCount()) return pool;
+    SchedulerOptions options;
+    options.threads = threads;
+    own.reset(new TaskScheduler(options));
+    return *own;
+}
+
+unsigned TaskScheduler::currentWorker() const {
+    return currentScheduler == this ? currentIndex : workerCount();
+}
+
+void TaskScheduler::spawn(Task* task) {
+    unsigned self = currentWorker();
+    if (self < workerCount()) {
+        workers[self]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex);
+        injected.push_back(task);
+    }
+    // Paired with the sleeper's check of `available` after raising `sleepers`
+    available.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeUp.notify_one();
+    }
+}
+
+TaskScheduler::Task* TaskScheduler::findTask(unsigned self) {
+    Task* task = workers[self]->deque.pop();
+    if (!task && workers.size() > 1) {
+        // Start at a random victim so thieves spread out
+        uint32_t& x = workers[self]->victimSeed;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        const size_t count = workers.size();
+        size_t start = x % count;
+        for (size_t k = 0; k < count && !task; k++) {
+            size_t victim = (start + k) % count;
+            if (victim != self) task = workers[victim]->deque.steal();
+        }
+    }
+    if (!task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!injected.empty()) {
+            task = injected.front();
+            injected.pop_front();
+        }
+    }
+    if (task) available.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+void TaskScheduler::execute(Task* task) {
+    TaskGroup* group = task->group;
+    if (!group->cancelled()) task->run();
+    delete task;
+    group->finishOne();
+}
+
+void TaskScheduler::workerLoop(unsigned index) {
+    currentScheduler = this;
+    currentIndex = index;
+    while (true) {
+        if (Task* task = findTask(index)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        wakeUp.wait(lock, [&]() { return stopping || available.load(std::memory_order_seq_cst) > 0; });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping) return;
+    }
+}
+
+void TaskScheduler::splitRange(const std::shared_ptr<Range>& range, size_t first, size_t last) {
+    // Lazy binary splitting: hand the upper half to thieves only while this
+    // worker's deque is empty, i.e. while nobody has anything left to steal
+    Worker* self = currentWorker() < workerCount() ? workers[currentWorker()].get() : nullptr;
+    while (first < last && !range->group->cancelled()) {
+        if (last - first > 2 * range->grain && (!self || self->deque.empty())) {
+            size_t middle = first + (last - first) / 2;
+            range->group->run([this, range, middle, last]() { splitRange(range, middle, last); });
+            last = middle;
+            continue;
+        }
+        size_t stop = std::min(first + range->grain, last);
+        range->body(first, stop);
+        first = stop;
+    }
+}
+
+void TaskScheduler::parallelFor(TaskGroup& group, size_t begin, size_t end,
+                                std::function<void(size_t, size_t)> body, size_t grain) {
+    if (begin >= end) return;
+    if (grain == 0) grain = std::max<size_t>((end - begin) / (workerCount() * PIECES_PER_WORKER), 1);
+    std::shared_ptr<Range> range(new Range{ std::move(body), grain, &group });
+    group.run([this, range, begin, end]() { splitRange(range, begin, end); });
+}
+
+void TaskScheduler::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain) {
+    TaskGroup group(*this);
+    parallelFor(group, begin, end, body, grain);
+    group.wait();
+}
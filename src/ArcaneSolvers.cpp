@@ -0,0 +1,353 @@
+#include "../include/ArcaneSolvers.h"
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// Roots of a t^2 + b t + c = 0 given disc = b^2 - 4ac >= 0 and a != 0, as
+// plus = (-b + sqrt(disc)) / 2a and minus = (-b - sqrt(disc)) / 2a. Uses the
+// cancellation-free form so the small root keeps its precision when |b| is
+// large, which the textbook formula loses for long flights.
+template <typename T>
+inline void quadraticRoots(T a, T b, T c, T disc, T& plus, T& minus) {
+    T root = std::sqrt(disc);
+    if (b >= T(0)) {
+        T q = -T(0.5) * (b + root);
+        minus = q / a;
+        plus = (q != T(0)) ? c / q : T(0);
+    } else {
+        T q = T(0.5) * (root - b);
+        plus = q / a;
+        minus = c / q;
+    }
+}
+
+} // namespace
+
+// Fixed-point solve on radians; returns the number of iterations used
+template <typename T>
+int solveState(SolveState<T>& s) {
+    const T EPS = SOLVE_EPS<T>;
+    bool updated;
+    int iterations = 0;
+    const int MAX_ITERATIONS = 100;
+
+    if (s.thetaKnown) s.cacheTrig();
+
+    do {
+        updated = false;
+        iterations++;
+
+        // --- Horizontal motion ---
+
+        // Solve time from horizontal motion: d = vi * cos(theta) * t
+        if (!s.timeKnown && s.dKnown && s.viKnown && s.thetaKnown) {
+            if (std::abs(s.cosTheta) > EPS) {
+                s.time = s.d / (s.vi * s.cosTheta);
+                s.timeKnown = true;
+                updated = true;
+            }
+        }
+
+        // Solve horizontal distance: d = vi * cos(theta) * t
+        if (!s.dKnown && s.viKnown && s.thetaKnown && s.timeKnown) {
+            s.d = s.vi * s.cosTheta * s.time;
+            s.dKnown = true;
+            updated = true;
+        }
+
+        // Solve initial velocity from horizontal motion: vi = d / (cos(theta) * t)
+        if (!s.viKnown && s.dKnown && s.thetaKnown && s.timeKnown) {
+            if (std::abs(s.cosTheta) > EPS && std::abs(s.time) > EPS) {
+                s.vi = s.d / (s.cosTheta * s.time);
+                s.viKnown = true;
+                updated = true;
+            }
+        }
+
+        // Solve launch angle from horizontal motion: theta = acos(d / (vi * t))
+        if (!s.thetaKnown && s.dKnown && s.viKnown && s.timeKnown) {
+            T denom = s.vi * s.time;
+            if (std::abs(denom) > EPS) {
+                T cosTheta = s.d / denom;
+                if (cosTheta >= T(-1) && cosTheta <= T(1)) {
+                    s.theta = std::acos(cosTheta);
+                    s.thetaKnown = true;
+                    s.cacheTrig();
+                    updated = true;
+                }
+            }
+        }
+
+        // --- Vertical motion ---
+
+        // Assume yi = 0 if not known (projectile starts at ground level)
+        if (!s.yiKnown && !s.yfKnown && s.viKnown && s.timeKnown && s.gravityKnown && s.thetaKnown) {
+            s.yi = T(0);
+            s.yiKnown = true;
+            updated = true;
+        }
+
+        // Solve final vertical position: yf = yi + vi*sin(theta)*t - 0.5*g*t^2
+        if (!s.yfKnown && s.yiKnown && s.viKnown && s.timeKnown && s.gravityKnown && s.thetaKnown) {
+            s.yf = s.yi + s.vi * s.sinTheta * s.time - T(0.5) * s.gravity * s.time * s.time;
+            s.yfKnown = true;
+            updated = true;
+        }
+
+        // If final y position reaches ground (yf = 0) after traveling distance, projectile has landed
+        if (s.yfKnown && s.yf <= T(0) && s.yf != s.yi && s.dKnown && s.d > EPS) {
+            s.yf = T(0);
+            // Stop further iterations to represent landing
+            updated = false;
+        }
+
+        // Solve initial vertical position: yi = yf - vi*sin(theta)*t + 0.5*g*t^2
+        if (!s.yiKnown && s.yfKnown && s.viKnown && s.timeKnown && s.gravityKnown && s.thetaKnown) {
+            s.yi = s.yf - s.vi * s.sinTheta * s.time + T(0.5) * s.gravity * s.time * s.time;
+            s.yiKnown = true;
+            updated = true;
+        }
+
+        // Solve initial velocity from vertical motion: vi = (yf - yi + 0.5*g*t^2) / (sin(theta)*t)
+        if (!s.viKnown && s.yiKnown && s.yfKnown && s.timeKnown && s.gravityKnown && s.thetaKnown) {
+            if (std::abs(s.sinTheta) > EPS && std::abs(s.time) > EPS) {
+                s.vi = (s.yf - s.yi + T(0.5) * s.gravity * s.time * s.time) / (s.sinTheta * s.time);
+                s.viKnown = true;
+                updated = true;
+            }
+        }
+
+        // Solve launch angle from vertical motion: theta = asin((yf - yi + 0.5*g*t^2) / (vi*t))
+        if (!s.thetaKnown && s.yiKnown && s.yfKnown && s.viKnown && s.timeKnown && s.gravityKnown) {
+            T denom = s.vi * s.time;
+            if (std::abs(denom) > EPS) {
+                T sinTheta = (s.yf - s.yi + T(0.5) * s.gravity * s.time * s.time) / denom;
+                if (sinTheta >= T(-1) && sinTheta <= T(1)) {
+                    s.theta = std::asin(sinTheta);
+                    s.thetaKnown = true;
+                    s.cacheTrig();
+                    updated = true;
+                }
+            }
+        }
+
+        // Solve time from vertical motion (quadratic): yf = yi + vi*sin(theta)*t - 0.5*g*t^2
+        if (!s.timeKnown && s.yiKnown && s.yfKnown && s.viKnown && s.gravityKnown && s.thetaKnown) {
+            T a = -T(0.5) * s.gravity;
+            T b = s.vi * s.sinTheta;
+            T c = s.yi - s.yf;
+
+            T disc = b*b - 4*a*c;
+            if (disc >= 0 && std::abs(a) > EPS) {
+                T t1, t2;
+                quadraticRoots(a, b, c, disc, t1, t2);
+                s.time = (t1 > EPS) ? t1 : t2;
+                s.timeKnown = true;
+                updated = true;
+            }
+        }
+
+        // Special case: if final height unknown, solve for landing time by setting yf = 0 (ground)
+        if (!s.timeKnown && s.yiKnown && !s.yfKnown && s.viKnown && s.gravityKnown && s.thetaKnown) {
+            // Solve: 0 = yi + vi*sin(theta)*t - 0.5*g*t^2
+            // Rearrange: 0.5*g*t^2 - vi*sin(theta)*t - yi = 0
+            T a = T(0.5) * s.gravity;
+            T b = -s.vi * s.sinTheta;
+            T c = -s.yi;
+
+            T disc = b*b - 4*a*c;
+            if (disc >= 0 && std::abs(a) > EPS) {
+                T t1, t2;
+                quadraticRoots(a, b, c, disc, t1, t2);
+                // Take the positive root (the landing time)
+                s.time = (t1 > EPS) ? t1 : t2;
+                if (s.time > EPS) {
+                    s.timeKnown = true;
+                    s.yfKnown = false; // Allow yf to be computed next iteration as 0
+                    updated = true;
+                }
+            }
+        }
+
+        // --- Final velocity magnitude ---
+
+        // Solve final velocity magnitude: vf = sqrt(vx^2 + vy^2)
+        if (!s.vfKnown && s.viKnown && s.gravityKnown && s.timeKnown && s.thetaKnown) {
+            T vx = s.vi * s.cosTheta;                      // horizontal velocity (constant)
+            T vy = s.vi * s.sinTheta - s.gravity * s.time; // vertical velocity
+            s.vf = std::sqrt(vx*vx + vy*vy);
+            s.vfKnown = true;
+            updated = true;
+        }
+
+    } while(updated && iterations < MAX_ITERATIONS);
+
+    return iterations;
+}
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Mask-specialized solvers
+//
+// For a fixed known-mask the loop above always fires the same equations in the
+// same order; only the runtime guards (non-zero divisors, real roots) and the
+// landing clamp depend on the values. buildSolvePlan records that order at
+// compile time and solveMask<Mask> replays it as straight-line code.
+// ---------------------------------------------------------------------------
+
+template <unsigned Mask>
+constexpr SolvePlan PLAN = buildSolvePlan(Mask);
+
+const int STEP_NEXT = 0;      // keep going
+const int STEP_FALLBACK = -1; // a guard failed, rerun through solveState
+// any positive value: the landing clamp stopped the loop after that many iterations
+
+template <typename T, unsigned Mask, size_t I>
+inline int runStep(SolveState<T>& s) {
+    constexpr SolveStep step = PLAN<Mask>.steps[I];
+    constexpr T EPS = SOLVE_EPS<T>;
+
+    if constexpr (step.rule == RULE_TIME_FROM_HORIZONTAL) {
+        if (!(std::abs(s.cosTheta) > EPS)) return STEP_FALLBACK;
+        s.time = s.d / (s.vi * s.cosTheta);
+        s.timeKnown = true;
+    } else if constexpr (step.rule == RULE_D_FROM_HORIZONTAL) {
+        s.d = s.vi * s.cosTheta * s.time;
+        s.dKnown = true;
+    } else if constexpr (step.rule == RULE_VI_FROM_HORIZONTAL) {
+        if (!(std::abs(s.cosTheta) > EPS && std::abs(s.time) > EPS)) return STEP_FALLBACK;
+        s.vi = s.d / (s.cosTheta * s.time);
+        s.viKnown = true;
+    } else if constexpr (step.rule == RULE_THETA_FROM_HORIZONTAL) {
+        T denom = s.vi * s.time;
+        if (!(std::abs(denom) > EPS)) return STEP_FALLBACK;
+        T cosTheta = s.d / denom;
+        if (!(cosTheta >= T(-1) && cosTheta <= T(1))) return STEP_FALLBACK;
+        s.theta = std::acos(cosTheta);
+        s.thetaKnown = true;
+        s.cacheTrig();
+    } else if constexpr (step.rule == RULE_ASSUME_YI) {
+        s.yi = T(0);
+        s.yiKnown = true;
+    } else if constexpr (step.rule == RULE_YF_FROM_VERTICAL) {
+        s.yf = s.yi + s.vi * s.sinTheta * s.time - T(0.5) * s.gravity * s.time * s.time;
+        s.yfKnown = true;
+    } else if constexpr (step.rule == RULE_LANDING) {
+        if (s.yf <= T(0) && s.yf != s.yi && s.d > EPS) {
+            s.yf = T(0);
+            if constexpr (step.terminal) return step.iteration;
+        }
+    } else if constexpr (step.rule == RULE_YI_FROM_VERTICAL) {
+        s.yi = s.yf - s.vi * s.sinTheta * s.time + T(0.5) * s.gravity * s.time * s.time;
+        s.yiKnown = true;
+    } else if constexpr (step.rule == RULE_VI_FROM_VERTICAL) {
+        if (!(std::abs(s.sinTheta) > EPS && std::abs(s.time) > EPS)) return STEP_FALLBACK;
+        s.vi = (s.yf - s.yi + T(0.5) * s.gravity * s.time * s.time) / (s.sinTheta * s.time);
+        s.viKnown = true;
+    } else if constexpr (step.rule == RULE_THETA_FROM_VERTICAL) {
+        T denom = s.vi * s.time;
+        if (!(std::abs(denom) > EPS)) return STEP_FALLBACK;
+        T sinTheta = (s.yf - s.yi + T(0.5) * s.gravity * s.time * s.time) / denom;
+        if (!(sinTheta >= T(-1) && sinTheta <= T(1))) return STEP_FALLBACK;
+        s.theta = std::asin(sinTheta);
+        s.thetaKnown = true;
+        s.cacheTrig();
+    } else if constexpr (step.rule == RULE_TIME_FROM_VERTICAL) {
+        T a = -T(0.5) * s.gravity;
+        T b = s.vi * s.sinTheta;
+        T c = s.yi - s.yf;
+        T disc = b*b - 4*a*c;
+        if (!(disc >= 0 && std::abs(a) > EPS)) return STEP_FALLBACK;
+        T t1, t2;
+        quadraticRoots(a, b, c, disc, t1, t2);
+        s.time = (t1 > EPS) ? t1 : t2;
+        s.timeKnown = true;
+    } else if constexpr (step.rule == RULE_TIME_FROM_LANDING) {
+        T a = T(0.5) * s.gravity;
+        T b = -s.vi * s.sinTheta;
+        T c = -s.yi;
+        T disc = b*b - 4*a*c;
+        if (!(disc >= 0 && std::abs(a) > EPS)) return STEP_FALLBACK;
+        T t1, t2;
+        quadraticRoots(a, b, c, disc, t1, t2);
+        s.time = (t1 > EPS) ? t1 : t2;
+        if (!(s.time > EPS)) return STEP_FALLBACK;
+        s.timeKnown = true;
+    } else if constexpr (step.rule == RULE_VF_FROM_COMPONENTS) {
+        T vx = s.vi * s.cosTheta;
+        T vy = s.vi * s.sinTheta - s.gravity * s.time;
+        s.vf = std::sqrt(vx*vx + vy*vy);
+        s.vfKnown = true;
+    }
+    return STEP_NEXT;
+}
+
+template <typename T, unsigned Mask, size_t... I>
+inline int runPlan(SolveState<T>& s, std::index_sequence<I...>) {
+    int result = STEP_NEXT;
+    // Runs the steps in order and stops at the first one that does not continue
+    (void)((((result = runStep<T, Mask, I>(s)) == STEP_NEXT) && ...));
+    return result;
+}
+
+template <typename T, unsigned Mask>
+int solveMask(SolveState<T>& s) {
+    constexpr SolvePlan plan = PLAN<Mask>;
+    if constexpr (plan.count == 0) {
+        return plan.iterations;
+    } else {
+        const SolveState<T> input = s;
+        if constexpr ((Mask & KNOWN_THETA) != 0) s.cacheTrig();
+
+        int result = runPlan<T, Mask>(s, std::make_index_sequence<plan.count>{});
+        if (result == STEP_NEXT) return plan.iterations;
+        if (result > 0) return result;
+
+        // Rare: a divisor or discriminant guard rejected the values
+        s = input;
+        return solveState(s);
+    }
+}
+
+template <typename T>
+using MaskSolver = int (*)(SolveState<T>&);
+
+template <typename T, size_t... M>
+constexpr std::array<MaskSolver<T>, 256> makeSolverTable(std::index_sequence<M...>) {
+    return {{ &solveMask<T, M>... }};
+}
+
+template <size_t... M>
+constexpr std::array<SolvePlan, 256> makePlanTable(std::index_sequence<M...>) {
+    return {{ PLAN<M>... }};
+}
+
+template <typename T>
+constexpr std::array<MaskSolver<T>, 256> SOLVERS = makeSolverTable<T>(std::make_index_sequence<256>{});
+constexpr std::array<SolvePlan, 256> PLANS = makePlanTable(std::make_index_sequence<256>{});
+
+} // namespace
+
+template <typename T>
+int solveSpecialized(SolveState<T>& s) {
+    return SOLVERS<T>[s.knownMask()](s);
+}
+
+const SolvePlan& solvePlan(unsigned mask) {
+    return PLANS[mask & 0xFF];
+}
+
+bool isMaskSolvable(unsigned mask) {
+    return PLANS[mask & 0xFF].solvedMask == KNOWN_ALL;
+}
+
+template int solveState<float>(SolveState<float>&);
+template int solveState<double>(SolveState<double>&);
+template int solveState<long double>(SolveState<long double>&);
+
+template int solveSpecialized<float>(SolveState<float>&);
+template int solveSpecialized<double>(SolveState<double>&);
+template int solveSpecialized<long double>(SolveState<long double>&);
@@ -0,0 +1,281 @@
+#include "../include/ArcaneSweep.h"
+#include "../include/ArcaneScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const char CHECKPOINT_MAGIC[8] = { 'A', 'R', 'C', 'S', 'W', 'E', 'E', 'P' };
+const uint32_t CHECKPOINT_VERSION = 1;
+
+// Checkpoint layout (native byte order):
+//   magic[8], version u32, reserved u32, tileSize u64,
+//   4 x { min f32, max f32, steps u64 } for theta, vi, h0, g,
+//   one done-byte per tile, then the range, apex, flightTime and impactSpeed
+//   arrays, spec.count() floats each.
+class SweepCheckpoint {
+    public:
+        // Opens an existing checkpoint for the same grid and loads its finished
+        // tiles, or starts a new one. Returns false if the file is unusable.
+        bool open(const char* path, const SweepSpec& spec, size_t tileSize,
+                  std::vector<unsigned char>& done, SweepResults& results) {
+            points = spec.count();
+            tiles = done.size();
+            this->tileSize = tileSize;
+            makeHeader(spec, tileSize);
+            dataOffset = (std::streamoff)(header.size() + tiles);
+
+            if (load(path, done, results)) return true;
+
+            std::ofstream create(path, std::ios::binary | std::ios::trunc);
+            create.write(header.data(), (std::streamsize)header.size());
+            std::vector<char> zeros(tiles, 0);
+            create.write(zeros.data(), (std::streamsize)zeros.size());
+            create.close();
+            if (!create) return false;
+
+            file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+            return (bool)file;
+        }
+
+        // Writes the outputs of the given tiles, then marks them done. Runs of
+        // adjacent tiles go out as one write per array.
+        bool save(std::vector<size_t>& finished, const SweepResults& results) {
+            if (finished.empty()) return true;
+            std::sort(finished.begin(), finished.end());
+            const std::vector<float>* arrays[4] = {
+                &results.range, &results.apex, &results.flightTime, &results.impactSpeed
+            };
+            forEachRun(finished, [&](size_t firstTile, size_t tileCount) {
+                size_t begin = firstTile * tileSize;
+                size_t count = std::min(tileCount * tileSize, points - begin);
+                for (int a = 0; a < 4; a++) {
+                    file.seekp(dataOffset + (std::streamoff)((a * points + begin) * sizeof(float)));
+                    file.write(reinterpret_cast<const char*>(arrays[a]->data() + begin),
+                               (std::streamsize)(count * sizeof(float)));
+                }
+            });
+            file.flush();
+            forEachRun(finished, [&](size_t firstTile, size_t tileCount) {
+                std::vector<char> ones(tileCount, 1);
+                file.seekp((std::streamoff)(header.size() + firstTile));
+                file.write(ones.data(), (std::streamsize)tileCount);
+            });
+            file.flush();
+            return (bool)file;
+        }
+
+    private:
+        // Calls fn(first, count) for each run of consecutive tiles in a sorted list
+        template <typename Fn>
+        static void forEachRun(const std::vector<size_t>& sorted, Fn fn) {
+            size_t start = 0;
+            for (size_t i = 1; i <= sorted.size(); i++) {
+                if (i == sorted.size() || sorted[i] != sorted[i - 1] + 1) {
+                    fn(sorted[start], i - start);
+                    start = i;
+                }
+            }
+        }
+
+        template <typename V>
+        void put(V value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            header.insert(header.end(), bytes, bytes + sizeof(V));
+        }
+
+        void makeHeader(const SweepSpec& spec, size_t tileSize) {
+            header.assign(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+            put<uint32_t>(CHECKPOINT_VERSION);
+            put<uint32_t>(0);
+            put<uint64_t>(tileSize);
+            for (const SweepAxis* axis : { &spec.theta, &spec.vi, &spec.h0, &spec.g }) {
+                put<float>(axis->min);
+                put<float>(axis->max);
+                put<uint64_t>(axis->steps);
+            }
+        }
+
+        bool load(const char* path, std::vector<unsigned char>& done, SweepResults& results) {
+            file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+            if (!file) {
+                file.clear();
+                return false;
+            }
+
+            std::vector<char> existing(header.size());
+            file.read(existing.data(), (std::streamsize)existing.size());
+            if (!file || existing != header) {
+                std::cerr << "Warning: checkpoint '" << path << "' is for a different sweep, starting over\n";
+                file.close();
+                file.clear();
+                return false;
+            }
+            file.read(reinterpret_cast<char*>(done.data()), (std::streamsize)tiles);
+            if (!file) {
+                file.close();
+                file.clear();
+                return false;
+            }
+
+            std::vector<float>* arrays[4] = {
+                &results.range, &results.apex, &results.flightTime, &results.impactSpeed
+            };
+            size_t restored = 0;
+            for (size_t tile = 0; tile < tiles; tile++) {
+                if (!done[tile]) continue;
+                size_t begin = tile * tileSize;
+                size_t count = std::min(tileSize, points - begin);
+                for (int a = 0; a < 4; a++) {
+                    file.seekg(dataOffset + (std::streamoff)((a * points + begin) * sizeof(float)));
+                    file.read(reinterpret_cast<char*>(arrays[a]->data() + begin),
+                              (std::streamsize)(count * sizeof(float)));
+                }
+                if (!file) {
+                    // Truncated data: redo this tile and everything after it
+                    file.clear();
+                    for (size_t rest = tile; rest < tiles; rest++) done[rest] = 0;
+                    break;
+                }
+                restored++;
+            }
+            if (restored > 0) {
+                std::cerr << "Resuming sweep: " << restored << " of " << tiles << " tiles already done\n";
+            }
+            return true;
+        }
+
+        std::fstream file;
+        std::vector<char> header;
+        std::streamoff dataOffset = 0;
+        size_t points = 0;
+        size_t tiles = 0;
+        size_t tileSize = 0;
+};
+
+} // namespace
+
+// Closed-form landing on y = 0. The flight time is the positive root of
+// g/2 t^2 - vy t - h0 = 0, taken in the form that avoids cancellation.
+void ArcaneSweep::computeTile(size_t begin, size_t end, SweepResults& results,
+                              const std::vector<double>& sinTheta, const std::vector<double>& cosTheta) const {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const size_t nt = spec.theta.steps, nv = spec.vi.steps, nh = spec.h0.steps;
+
+    size_t p = begin;
+    while (p < end) {
+        size_t it = p % nt;
+        size_t rest = p / nt;
+        const double v = spec.vi.at(rest % nv);
+        rest /= nv;
+        const double h = spec.h0.at(rest % nh);
+        const double g = spec.g.at(rest / nh);
+        const size_t runEnd = std::min(end, p + (nt - it));
+
+        for (; p < runEnd; ++p, ++it) {
+            const double vx = v * cosTheta[it];
+            const double vy = v * sinTheta[it];
+            const double disc = vy * vy + 2.0 * g * h;
+            if (!(g > 0.0) || disc < 0.0) {
+                results.range[p] = results.apex[p] = results.flightTime[p] = results.impactSpeed[p] = nan;
+                continue;
+            }
+            const double s = std::sqrt(disc); // |vertical speed| at landing
+            const double t = vy >= 0.0 ? (vy + s) / g : 2.0 * h / (s - vy);
+            if (t < 0.0) {
+                results.range[p] = results.apex[p] = results.flightTime[p] = results.impactSpeed[p] = nan;
+                continue;
+            }
+            results.range[p] = (float)(vx * t);
+            results.apex[p] = (float)(vy > 0.0 ? h + vy * vy / (2.0 * g) : h);
+            results.flightTime[p] = (float)t;
+            results.impactSpeed[p] = (float)std::sqrt(vx * vx + disc);
+        }
+    }
+}
+
+bool ArcaneSweep::run(SweepResults& results, const SweepOptions& options) {
+    const size_t points = spec.count();
+    const size_t tileSize = options.tileSize > 0 ? options.tileSize : 16384;
+    const size_t tiles = (points + tileSize - 1) / tileSize;
+
+    results.range.resize(points);
+    results.apex.resize(points);
+    results.flightTime.resize(points);
+    results.impactSpeed.resize(points);
+    cancelled = false;
+    completed = 0;
+    if (points == 0) return true;
+
+    std::vector<unsigned char> done(tiles, 0);
+    SweepCheckpoint checkpoint;
+    const bool checkpointing = options.checkpointPath != nullptr;
+    if (checkpointing && !checkpoint.open(options.checkpointPath, spec, tileSize, done, results)) {
+        std::cerr << "Error: cannot write checkpoint '" << options.checkpointPath << "'\n";
+        return false;
+    }
+
+    std::vector<size_t> pending;
+    pending.reserve(tiles);
+    for (size_t tile = 0; tile < tiles; tile++) {
+        if (done[tile]) completed += std::min(tileSize, points - tile * tileSize);
+        else pending.push_back(tile);
+    }
+
+    // Trig depends only on theta, so each worker reads it from a table
+    std::vector<double> sinTheta(spec.theta.steps), cosTheta(spec.theta.steps);
+    for (size_t i = 0; i < spec.theta.steps; i++) {
+        double radians = spec.theta.at(i) * PI / 180.0;
+        sinTheta[i] = std::sin(radians);
+        cosTheta[i] = std::cos(radians);
+    }
+
+    std::unique_ptr<TaskScheduler> ownScheduler;
+    TaskScheduler& scheduler = TaskScheduler::select(options.threads, ownScheduler);
+
+    std::mutex finishedMutex;
+    std::vector<size_t> finished; // tiles done since the last checkpoint write
+
+    TaskGroup group(scheduler);
+    scheduler.parallelFor(group, 0, pending.size(), [&](size_t firstSlot, size_t lastSlot) {
+        for (size_t slot = firstSlot; slot < lastSlot && !cancelled; slot++) {
+            size_t begin = pending[slot] * tileSize;
+            size_t end = std::min(begin + tileSize, points);
+            computeTile(begin, end, results, sinTheta, cosTheta);
+            completed += end - begin;
+            if (checkpointing) {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                finished.push_back(pending[slot]);
+            }
+        }
+    }, 1);
+
+    bool ok = true;
+    if (checkpointing) {
+        const double interval = options.checkpointInterval > 0.0 ? options.checkpointInterval : 5.0;
+        std::vector<size_t> batch;
+        while (true) {
+            bool allDone = group.waitFor(interval);
+            {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                batch.swap(finished);
+            }
+            if (!checkpoint.save(batch, results) && ok) {
+                std::cerr << "Error: failed writing checkpoint '" << options.checkpointPath << "'\n";
+                ok = false;
+            }
+            batch.clear();
+            if (allDone) break;
+        }
+    }
+    group.wait();
+
+    return ok && !cancelled;
+}
@@ -0,0 +1,105 @@
+#include "../include/ArcaneTargeting.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+template <typename T>
+const T DEGREES_PER_RADIAN = T(57.295779513082320876798154814105L);
+
+// With u = tan(theta), hitting (d, dy) at speed v means
+//   a u^2 - d u + (a + dy) = 0,   a = g d^2 / (2 v^2)
+// The roots are taken as q / a (high arc) and c / q (low arc) with
+// q = (d + sqrt(disc)) / 2, which avoids cancellation for near-grazing and
+// near-flat shots, and the angles come from atan2 so no tangent overflows.
+template <typename T>
+int arcs(T g, T dy, T v, T d, TargetArc<T> out[2]) {
+    if (!(g > T(0)) || !(v > T(0))) return 0;
+
+    if (d == T(0)) {
+        // Straight up (or down): dy = v t - g t^2 / 2 along the vertical
+        T disc = v * v - T(2) * g * dy;
+        if (disc < T(0)) return 0;
+        T s = std::sqrt(disc);
+        if (dy >= T(0)) {
+            out[0] = { T(90), T(2) * dy / (v + s) }; // on the way up
+            out[1] = { T(90), (v + s) / g };         // on the way down
+            return disc == T(0) ? 1 : 2;
+        }
+        out[0] = { T(-90), T(-2) * dy / (v + s) }; // thrown straight down
+        out[1] = { T(90), (v + s) / g };          // up and back past the launch point
+        return 2;
+    }
+
+    T a = g * d * d / (T(2) * v * v);
+    T c = a + dy;
+    T disc = d * d - T(4) * a * c;
+    if (disc < T(0)) {
+        // Rounding can push an exactly grazing shot just below zero
+        if (disc < -T(16) * std::numeric_limits<T>::epsilon() * d * d) return 0;
+        disc = T(0);
+    }
+    T q = T(0.5) * (d + std::sqrt(disc));
+
+    // time = d / (v cos(theta)) with cos(theta) = x / hypot(x, y) for theta = atan2(y, x)
+    out[0] = { std::atan2(c, q) * DEGREES_PER_RADIAN<T>, d * std::hypot(q, c) / (v * q) };
+    out[1] = { std::atan2(q, a) * DEGREES_PER_RADIAN<T>, d * std::hypot(q, a) / (v * a) };
+    return disc == T(0) ? 1 : 2;
+}
+
+// The slowest shot reaching (d, dy) has v^2 = g (dy + r) with r = |(d, dy)|,
+// bisects the angle between the target direction and straight up, and takes
+// sqrt(2 r / g)
+template <typename T>
+void minimumSpeed(T g, T dy, T d, T& speed, T& theta, T& time) {
+    if (!(g > T(0))) {
+        speed = theta = time = std::numeric_limits<T>::quiet_NaN();
+        return;
+    }
+    T r = std::hypot(d, dy);
+    speed = std::sqrt(g * (dy + r));
+    theta = T(45) + T(0.5) * std::atan2(dy, d) * DEGREES_PER_RADIAN<T>;
+    time = std::sqrt(T(2) * r / g);
+}
+
+} // namespace
+
+template <typename T>
+TargetSolution<T> solveTarget(T gravity, T yi, T yf, T vi, T d) {
+    TargetSolution<T> solution;
+    solution.count = arcs(gravity, yf - yi, vi, std::abs(d), solution.arcs);
+    minimumSpeed(gravity, yf - yi, std::abs(d), solution.minSpeed, solution.minSpeedTheta, solution.minSpeedTime);
+    return solution;
+}
+
+template <typename T>
+void solveTargets(const TargetBatch<T>& batch) {
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    for (size_t i = 0; i < batch.count; ++i) {
+        const T dy = batch.yf[i] - batch.yi[i];
+        const T d = std::abs(batch.d[i]);
+
+        TargetArc<T> found[2];
+        int n = arcs(batch.gravity[i], dy, batch.vi[i], d, found);
+        batch.lowTheta[i] = n > 0 ? found[0].theta : nan;
+        batch.lowTime[i] = n > 0 ? found[0].time : nan;
+        batch.highTheta[i] = n > 0 ? found[1].theta : nan;
+        batch.highTime[i] = n > 0 ? found[1].time : nan;
+        if (batch.arcCount) batch.arcCount[i] = (unsigned char)n;
+
+        if (batch.minSpeed || batch.minSpeedTheta) {
+            T speed, theta, time;
+            minimumSpeed(batch.gravity[i], dy, d, speed, theta, time);
+            if (batch.minSpeed) batch.minSpeed[i] = speed;
+            if (batch.minSpeedTheta) batch.minSpeedTheta[i] = theta;
+        }
+    }
+}
+
+template TargetSolution<float> solveTarget<float>(float, float, float, float, float);
+template TargetSolution<double> solveTarget<double>(double, double, double, double, double);
+template TargetSolution<long double> solveTarget<long double>(long double, long double, long double, long double, long double);
+
+template void solveTargets<float>(const TargetBatch<float>&);
+template void solveTargets<double>(const TargetBatch<double>&);
+template void solveTargets<long double>(const TargetBatch<long double>&);
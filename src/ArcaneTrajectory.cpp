@@ -0,0 +1,130 @@
+#include "../include/ArcaneTrajectory.h"
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define ARCANE_TRAJECTORY_X86 1
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+// Per-trajectory constants, computed once so the kernels never touch trig
+struct TrajectoryCoeffs {
+    float vx0, vy0, h0, g, halfG;
+};
+
+using TrajectoryKernel = void (*)(const TrajectoryCoeffs&, float t0, float dt,
+                                  size_t begin, size_t end,
+                                  const TrajectorySamples& out, float yFloor);
+
+// Reference kernel; also finishes the tail of the vector kernels. The vector
+// kernels evaluate the same expressions in the same order without FMA, so the
+// results match this one exactly.
+void sampleScalar(const TrajectoryCoeffs& c, float t0, float dt,
+                  size_t begin, size_t end,
+                  const TrajectorySamples& out, float yFloor) {
+    for (size_t i = begin; i < end; ++i) {
+        float t = t0 + (float)i * dt;
+        float y = c.h0 + c.vy0 * t - c.halfG * t * t;
+        float vy = c.vy0 - c.g * t;
+        if (out.t) out.t[i] = t;
+        if (out.x) out.x[i] = c.vx0 * t;
+        if (out.y) out.y[i] = y < yFloor ? yFloor : y;
+        if (out.vx) out.vx[i] = c.vx0;
+        if (out.vy) out.vy[i] = vy;
+        if (out.speed) out.speed[i] = std::sqrt(c.vx0 * c.vx0 + vy * vy);
+    }
+}
+
+#ifdef ARCANE_TRAJECTORY_X86
+
+__attribute__((target("sse2")))
+void sampleSSE(const TrajectoryCoeffs& c, float t0, float dt,
+               size_t begin, size_t end,
+               const TrajectorySamples& out, float yFloor) {
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 vt0 = _mm_set1_ps(t0), vdt = _mm_set1_ps(dt);
+    const __m128 vx0 = _mm_set1_ps(c.vx0), vy0 = _mm_set1_ps(c.vy0);
+    const __m128 h0 = _mm_set1_ps(c.h0), g = _mm_set1_ps(c.g), halfG = _mm_set1_ps(c.halfG);
+    const __m128 floorY = _mm_set1_ps(yFloor);
+    const __m128 vx0Sq = _mm_mul_ps(vx0, vx0);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 t = _mm_add_ps(vt0, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lane), vdt));
+        __m128 y = _mm_sub_ps(_mm_add_ps(h0, _mm_mul_ps(vy0, t)), _mm_mul_ps(_mm_mul_ps(halfG, t), t));
+        __m128 vy = _mm_sub_ps(vy0, _mm_mul_ps(g, t));
+        if (out.t) _mm_storeu_ps(out.t + i, t);
+        if (out.x) _mm_storeu_ps(out.x + i, _mm_mul_ps(vx0, t));
+        if (out.y) _mm_storeu_ps(out.y + i, _mm_max_ps(y, floorY));
+        if (out.vx) _mm_storeu_ps(out.vx + i, vx0);
+        if (out.vy) _mm_storeu_ps(out.vy + i, vy);
+        if (out.speed) _mm_storeu_ps(out.speed + i, _mm_sqrt_ps(_mm_add_ps(vx0Sq, _mm_mul_ps(vy, vy))));
+    }
+    sampleScalar(c, t0, dt, i, end, out, yFloor);
+}
+
+__attribute__((target("avx2")))
+void sampleAVX2(const TrajectoryCoeffs& c, float t0, float dt,
+                size_t begin, size_t end,
+                const TrajectorySamples& out, float yFloor) {
+    const __m256 lane = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 vt0 = _mm256_set1_ps(t0), vdt = _mm256_set1_ps(dt);
+    const __m256 vx0 = _mm256_set1_ps(c.vx0), vy0 = _mm256_set1_ps(c.vy0);
+    const __m256 h0 = _mm256_set1_ps(c.h0), g = _mm256_set1_ps(c.g), halfG = _mm256_set1_ps(c.halfG);
+    const __m256 floorY = _mm256_set1_ps(yFloor);
+    const __m256 vx0Sq = _mm256_mul_ps(vx0, vx0);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 t = _mm256_add_ps(vt0, _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lane), vdt));
+        __m256 y = _mm256_sub_ps(_mm256_add_ps(h0, _mm256_mul_ps(vy0, t)),
+                                 _mm256_mul_ps(_mm256_mul_ps(halfG, t), t));
+        __m256 vy = _mm256_sub_ps(vy0, _mm256_mul_ps(g, t));
+        if (out.t) _mm256_storeu_ps(out.t + i, t);
+        if (out.x) _mm256_storeu_ps(out.x + i, _mm256_mul_ps(vx0, t));
+        if (out.y) _mm256_storeu_ps(out.y + i, _mm256_max_ps(y, floorY));
+        if (out.vx) _mm256_storeu_ps(out.vx + i, vx0);
+        if (out.vy) _mm256_storeu_ps(out.vy + i, vy);
+        if (out.speed) _mm256_storeu_ps(out.speed + i, _mm256_sqrt_ps(_mm256_add_ps(vx0Sq, _mm256_mul_ps(vy, vy))));
+    }
+    sampleSSE(c, t0, dt, i, end, out, yFloor);
+}
+
+#endif
+
+struct KernelChoice {
+    TrajectoryKernel kernel;
+    const char* name;
+};
+
+KernelChoice chooseKernel() {
+#ifdef ARCANE_TRAJECTORY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return { sampleAVX2, "avx2" };
+    if (__builtin_cpu_supports("sse2")) return { sampleSSE, "sse" };
+#endif
+    return { sampleScalar, "scalar" };
+}
+
+const KernelChoice& kernel() {
+    static const KernelChoice choice = chooseKernel();
+    return choice;
+}
+
+} // namespace
+
+void sampleTrajectory(const TrajectoryParams& params, float t0, float dt, size_t count,
+                      const TrajectorySamples& out, float yFloor) {
+    TrajectoryCoeffs c;
+    c.vx0 = params.v0 * std::cos(params.theta);
+    c.vy0 = params.v0 * std::sin(params.theta);
+    c.h0 = params.h0;
+    c.g = params.g;
+    c.halfG = 0.5f * params.g;
+    kernel().kernel(c, t0, dt, 0, count, out, yFloor);
+}
+
+const char* trajectoryKernelName() {
+    return kernel().name;
+}
@@ -8,6 +8,193 @@
 #include <vector> // Required for std::vector
 #include <cstring>
 #include <../include/ArcaneMath.h>
+#include "../include/ArcaneTrajectory.h"
+#include "../include/ArcaneCache.h"
+#include "../include/ArcaneClock.h"
+#include "../include/ArcaneIntegrator.h"
+#include "../include/ArcaneAllocations.h"
+#include "../include/ArcaneArena.h"
+#include "../include/ArcaneJobs.h"
+#include "../include/ArcaneMonteCarlo.h"
+#include "../include/ArcanePlotSeries.h"
+#include "../include/ArcaneGpuTimer.h"
+#include "../include/ArcaneProfiler.h"
+#include "../include/ArcaneSampler.h"
+
+namespace {
+
+// Longest block while idle; also bounds how stale the idle metrics get
+const double IDLE_TIMEOUT_SECONDS = 1.0;
+// Keeps the text caret blinking while a text field has focus
+const double CARET_TIMEOUT_SECONDS = 0.5;
+// Frames drawn after every event or Wake(): ImGui needs a few to settle hover and
+// click state after input
+const int SETTLE_FRAMES = 3;
+
+// Bumped by every GLFW input and window callback, so WaitForEvents can tell
+// an event from a plain timeout. ImGui's GLFW backend chains to these.
+unsigned g_WindowEvents = 0;
+
+void CountWindowEvents(GLFWwindow* window) {
+    glfwSetCursorPosCallback(window, [](GLFWwindow*, double, double) { g_WindowEvents++; });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow*, int) { g_WindowEvents++; });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow*, int, int, int) { g_WindowEvents++; });
+    glfwSetScrollCallback(window, [](GLFWwindow*, double, double) { g_WindowEvents++; });
+    glfwSetKeyCallback(window, [](GLFWwindow*, int, int, int, int) { g_WindowEvents++; });
+    glfwSetCharCallback(window, [](GLFWwindow*, unsigned int) { g_WindowEvents++; });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow*, int) { g_WindowEvents++; });
+    glfwSetWindowSizeCallback(window, [](GLFWwindow*, int, int) { g_WindowEvents++; });
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow*, int, int) { g_WindowEvents++; });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { g_WindowEvents++; });
+}
+
+#ifdef ARCANE_ENABLE_PROFILING
+// Per-scope frame-time percentiles, the frame-time history and a flame chart
+// of one recorded frame (one row per thread and nesting depth)
+void DrawProfilerWindow(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(720, 560), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+    Profiler& profiler = Profiler::instance();
+    const int frames = (int)profiler.frameCount();
+
+    bool paused = profiler.isPaused();
+    if (ImGui::Checkbox("Freeze", &paused)) profiler.setPaused(paused);
+    ImGui::SameLine();
+    ImGui::Text("%d frames, %llu events dropped", frames, (unsigned long long)profiler.droppedEvents());
+    // The last frame's heap traffic on the frame thread; 0 is the goal
+    const bool allocations = allocationTrackingEnabled();
+    if (allocations && frames > 0) {
+        const AllocationCount& last = profiler.frame(frames - 1).allocations;
+        ImGui::Text("Last frame: %llu allocations, %llu bytes",
+                    (unsigned long long)last.count, (unsigned long long)last.bytes);
+    }
+    const PoolAllocator& pool = PoolAllocator::ui();
+    ImGui::Text("Frame arena peak %.1f KB, UI pool %.0f KB in slabs, %zu blocks live",
+                FrameArena::instance().highWater() / 1024.0, pool.slabBytes() / 1024.0, pool.liveBlocks());
+
+    if (ImGui::BeginTable("ProfilerScopes", allocations ? 8 : 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Scope (ms/frame)");
+        ImGui::TableSetupColumn("frames");
+        ImGui::TableSetupColumn("mean");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        if (allocations) ImGui::TableSetupColumn("allocs");
+        ImGui::TableHeadersRow();
+        for (const ProfileScopeStats& scope : profiler.scopeStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%s", scope.name);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", scope.frames);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.mean);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.p50);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.p95);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.p99);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.max);
+            if (allocations) { ImGui::TableNextColumn(); ImGui::Text("%.1f", scope.allocations); }
+        }
+        ImGui::EndTable();
+    }
+
+    // GPU side of the render passes, read back a few frames late
+    GpuTimer& gpu = GpuTimer::instance();
+    if (!gpu.supported()) {
+        ImGui::TextDisabled("GPU pass times need GL timer queries (GL 3.3)");
+    } else if (ImGui::BeginTable("ProfilerGpu", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("GPU pass (ms)");
+        ImGui::TableSetupColumn("last");
+        ImGui::TableSetupColumn("mean");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+        for (int pass = 0; pass < gpu.passCount(); ++pass) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%s", gpu.passName(pass));
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", gpu.lastMs(pass));
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", gpu.meanMs(pass));
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", gpu.maxMs(pass));
+        }
+        ImGui::EndTable();
+        if (gpu.droppedFrames() > 0) ImGui::Text("%llu GPU frames dropped (results not ready in time)",
+                                                 (unsigned long long)gpu.droppedFrames());
+    }
+
+    if (frames == 0) {
+        ImGui::End();
+        return;
+    }
+
+    FrameArena& scratch = FrameArena::instance();
+    float* frame_index = scratch.array<float>(frames);
+    float* frame_ms = scratch.array<float>(frames);
+    for (int i = 0; i < frames; ++i) {
+        const ProfileFrame& frame = profiler.frame(i);
+        frame_index[i] = (float)i;
+        frame_ms[i] = (float)((frame.end - frame.start) * 1e-6);
+    }
+    if (ImPlot::BeginPlot("Frame time", ImVec2(-1, 150), ImPlotFlags_NoLegend)) {
+        ImPlot::SetupAxes("frame", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        ImPlot::PlotLine("frame", frame_index, frame_ms, frames);
+        ImPlot::EndPlot();
+    }
+
+    static int selected_frame = -1; // -1 follows the latest frame
+    ImGui::SliderInt("Flame frame (-1 = latest)", &selected_frame, -1, frames - 1);
+    const ProfileFrame& frame = profiler.frame(selected_frame < 0 || selected_frame >= frames ? frames - 1 : selected_frame);
+
+    uint32_t threads = 0;
+    for (const ProfileEvent& event : frame.events) threads = std::max(threads, event.thread + 1);
+    int* first_row = scratch.array<int>(threads); // first flame row of each thread
+    std::fill(first_row, first_row + threads, 0);
+    for (const ProfileEvent& event : frame.events) {
+        first_row[event.thread] = std::max(first_row[event.thread], (int)event.depth + 1);
+    }
+    int rows = 0;
+    for (uint32_t t = 0; t < threads; ++t) {
+        int depth = first_row[t];
+        first_row[t] = rows;
+        rows += depth;
+    }
+
+    const float ROW_HEIGHT = ImGui::GetTextLineHeightWithSpacing();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    ImGui::Dummy(ImVec2(width, std::max(rows, 1) * ROW_HEIGHT));
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->PushClipRect(origin, ImVec2(origin.x + width, origin.y + std::max(rows, 1) * ROW_HEIGHT), true);
+
+    const double span = (double)std::max<uint64_t>(frame.end - frame.start, 1);
+    for (const ProfileEvent& event : frame.events) {
+        // Worker scopes may have started before the frame that drained them
+        double start = (double)(std::max(event.start, frame.start) - frame.start);
+        double end = (double)(std::max(event.end, frame.start) - frame.start);
+        ImVec2 lo(origin.x + (float)(start / span) * width, origin.y + (first_row[event.thread] + event.depth) * ROW_HEIGHT);
+        ImVec2 hi(origin.x + std::max((float)(end / span) * width, lo.x - origin.x + 1.0f), lo.y + ROW_HEIGHT - 1.0f);
+
+        // Stable colour per scope name
+        unsigned hash = 2166136261u;
+        for (const char* c = event.name; *c; ++c) hash = (hash ^ (unsigned char)*c) * 16777619u;
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB((hash % 360) / 360.0f, 0.45f, 0.9f, r, g, b);
+        draw_list->AddRectFilled(lo, hi, ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f)));
+        if (hi.x - lo.x > 40.0f) {
+            const char* label = hi.x - lo.x > 120.0f
+                ? scratch.format("%s %.2f ms", event.name, (event.end - event.start) * 1e-6)
+                : event.name;
+            draw_list->AddText(ImVec2(lo.x + 2.0f, lo.y), IM_COL32(0,0,0,255), label);
+        }
+        if (ImGui::IsMouseHoveringRect(lo, hi)) {
+            ImGui::SetTooltip("%s (thread %u)\n%.3f ms", event.name, event.thread, (event.end - event.start) * 1e-6);
+        }
+    }
+    draw_list->PopClipRect();
+    ImGui::End();
+}
+#endif
+
+} // namespace
 
 void SetArcaneDynamicsStyle() {
     
@@ -72,6 +259,9 @@ void SetArcaneDynamicsStyle() {
 
 void GUIRender::Init(GLFWwindow* window, const char* glsl_version) {
     IMGUI_CHECKVERSION();
+    // ImGui and ImPlot keep their windows, tables and buffers in the UI pool
+    // (its slabs are what ARCANE_TRACK_ALLOCATIONS counts)
+    ImGui::SetAllocatorFunctions(PoolAllocator::imguiAlloc, PoolAllocator::imguiFree, &PoolAllocator::ui());
     ImGui::CreateContext();
     ImPlot::CreateContext();
     SetArcaneDynamicsStyle();
@@ -81,14 +271,63 @@ void GUIRender::Init(GLFWwindow* window, const char* glsl_version) {
         "../include/Ancient-Medium.ttf", // <<< IMPORTANT: Update this path
         25.0f // Size of the font
     );
-    // Setup platform/render bindings
+    // Setup platform/render bindings (after our callbacks, so ImGui chains them)
+    CountWindowEvents(window);
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
 
+    // Sampling and Monte Carlo run on their own workers; a finished job
+    // wakes the frame loop
+    pathJobs.reset(new BackgroundWorker([this]() { Wake(); }));
+    mcJobs.reset(new BackgroundWorker([this]() { Wake(); }));
+}
+
+void GUIRender::WaitForEvents() {
+    double before = glfwGetTime();
+    if (renderOnDemand && redrawFrames <= 0 && !wakeRequested.exchange(false)) {
+        unsigned seen = g_WindowEvents;
+        glfwWaitEventsTimeout(ImGui::GetIO().WantTextInput ? CARET_TIMEOUT_SECONDS : IDLE_TIMEOUT_SECONDS);
+        // A bare timeout draws just this one frame (caret blink, idle stats)
+        if (g_WindowEvents != seen || wakeRequested.exchange(false)) RequestRedraw(SETTLE_FRAMES);
+    } else {
+        glfwPollEvents();
+    }
+    if (redrawFrames > 0) redrawFrames--;
+    double now = glfwGetTime();
+
+    // CPU time is process-wide (std::clock), so background threads count too
+    statsWaitSeconds += now - before;
+    statsFrames++;
+    double elapsed = now - statsStart;
+    if (elapsed >= 1.0) {
+        framesPerSecond = (float)(statsFrames / elapsed);
+        idlePercent = (float)(100.0 * statsWaitSeconds / elapsed);
+        cpuPercent = (float)(100.0 * (double)(std::clock() - statsCpuStart) / CLOCKS_PER_SEC / elapsed);
+        statsStart = now;
+        statsCpuStart = std::clock();
+        statsWaitSeconds = 0.0;
+        statsFrames = 0;
+    }
+}
+
+void GUIRender::RequestRedraw(int frames) {
+    redrawFrames = std::max(redrawFrames, frames);
+}
+
+void GUIRender::Wake() {
+    wakeRequested = true;
+    glfwPostEmptyEvent();
+}
 
+void GUIRender::SetScenario(float v0, float thetaDeg, float h0, float g) {
+    scenario = { v0, thetaDeg, h0, g };
+    hasScenario = true;
+    waitForPaths = true;
 }
 
 void GUIRender::NewFrame() {
+    // Last frame's scratch is done with
+    FrameArena::instance().reset();
     // feed inputs into imgui, start new frame
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -98,14 +337,24 @@ void GUIRender::NewFrame() {
 void GUIRender::Update(GLFWwindow* window) {
     // Persistent state to control plot visibility
     static bool g_ShowPlots = false;
-    // Persistent trajectory data arrays
-    static float plot_x_data[100] = {0};
-    static float plot_y_data[100] = {0};
-    static int plot_data_count = 0;
-    // Persistent velocity data arrays
-    static float plot_t_data[100] = {0};
-    static float plot_v_data[100] = {0};
-    static int plot_v_count = 0; 
+    // Persistent trajectory samples: one pass per solve feeds the position and
+    // velocity plots and the fireball animation. Sampling runs on the
+    // background worker, which publishes finished paths through a triple
+    // buffer; the frame shows the latest one and never waits for the next.
+    struct PathSnapshot {
+        TrajectoryBuffers path;
+        // Plot copies of the samples, decimated to the plot width each frame
+        PlotSeries pathSeries;
+        PlotSeries speedSeries;
+        IntegratorStats dragStats;
+        unsigned generation = 0; // CalculatePath call that produced it
+    };
+    static TrajectorySampler g_Sampler; // worker thread only
+    static TripleBuffer<PathSnapshot> g_PathBuffer;
+    static JobHandle g_PathJob;
+    static unsigned g_PathGeneration = 0;
+    static unsigned g_RunGeneration = 0; // start the animation once this path arrives
+    static int   plot_decimation         = 1; // Decimation: 0 = none, 1 = min/max, 2 = LTTB
 
     static const float GROUND_HEIGHT = 50.0f;
     static const float SHOOTER_OFFSET = 50.0f;
@@ -123,19 +372,36 @@ void GUIRender::Update(GLFWwindow* window) {
     static float padding_y_px            = 50.0f;
 
     static int   num_path_samples        = 100;
+    // Path sampling: 0 = uniform time, 1 = uniform arc length, 2 = fewest
+    // points within max_path_error_px of the curve at the current scale
+    static int   path_sample_policy      = 2;
+    static float max_path_error_px       = 0.5f;
+    static float path_sample_scale       = 20.0f; // px per meter the path was last sampled for
     static float ground_epsilon          = -0.01f;
 
     // Constant-scale option (user requested): keep px per meter fixed across runs
     static bool  g_UseConstantScale      = false;
     static float g_ScalePxPerMeter       = 20.0f; // reasonable default
 
-    static double g_TimeStart = 0.0;
+    // Results of recent Run presses keyed on the known inputs (to 1e-4)
+    static ArcaneSolveCache<float> g_SolveCache(256, 1e-4f);
+    static bool  g_UseSolveCache         = true;
+
+    // Animation runs on fixed simulation steps; rendering interpolates between
+    // the fireball state of the last two steps
+    struct FireballState { float t, x, y; };
+    static SimulationClock g_Clock;
+    static FireballState g_FireballPrev = { 0.0f, 0.0f, 0.0f };
+    static FireballState g_FireballCurr = { 0.0f, 0.0f, 0.0f };
+    static float g_PlaybackSpeed = 1.0f;
+
+#ifdef ARCANE_ENABLE_PROFILING
+    static bool g_ShowProfiler = false;
+#endif
     static const double g_SimulationDuration = 8.0;
     static bool g_IsAnimationRunning = false; 
+    static bool g_FitVelocityPlot = false; // refit once after a new solve
     
-    static std::vector<float> g_PathX;
-    static std::vector<float> g_PathY;
-
     static float g_FinalXPix = 0.0f;
     static float g_FinalYPix = 0.0f;
 
@@ -144,50 +410,107 @@ void GUIRender::Update(GLFWwindow* window) {
     static float THETA_DEG = 55.0f;
     static float G_MPS2 = 9.8f;
 
+    // Air drag: 0 = none (closed-form vacuum path), 1 = linear, 2 = quadratic
+    static int   g_DragModel            = 0;
+    static float g_DragCoeff            = 0.05f;
+    static int   g_IntegratorMethod     = 1; // 0 = RK4, 1 = Dormand-Prince
+
+    // Monte Carlo uncertainty on speed, angle and height: normal noise around
+    // the current value, uniform bounds, or observations loaded from a file
+    struct McInput {
+        int   kind;           // 0 = normal, 1 = uniform, 2 = empirical
+        float sigma;
+        float bounds[2];
+        char  path[256];
+        InputDistribution empirical; // Fixed until a file loads
+    };
+    static McInput g_McInputs[3] = {
+        { 0, 1.0f, { 35.0f, 45.0f }, "" }, // v (m/s)
+        { 0, 1.0f, { 50.0f, 60.0f }, "" }, // theta (deg)
+        { 0, 0.0f, { 45.0f, 55.0f }, "" }, // height (m)
+    };
+    static int   g_McSamples            = 200000;
+    static TripleBuffer<MonteCarloResult> g_McBuffer;
+    static JobHandle g_McJob;
+    static bool  g_McValid              = false;
+
     #ifndef M_PI
         #define M_PI 3.14159265358979323846
     #endif
 
-    // Generate path based on projectile physics
-    auto CalculatePath = [&]() {
-        g_PathX.clear();
-        g_PathY.clear();
+    auto MakeIntegratorOptions = [&]() {
+        IntegratorOptions options;
+        options.drag = (g_DragModel == 2) ? DragModel::Quadratic : DragModel::Linear;
+        options.dragCoeff = g_DragCoeff;
+        options.method = (g_IntegratorMethod == 0) ? IntegratorMethod::RK4 : IntegratorMethod::DormandPrince;
+        return options;
+    };
 
+    // Generate path based on projectile physics. Returns the generation the
+    // path will be published with; a still pending older request is dropped.
+    auto CalculatePath = [&]() {
         // Read current parameters from the mutable statics so animation matches solved values
-        const float V0 = V0_MPS;
-        const float Theta = THETA_DEG * (float)M_PI / 180.0f; // Convert to radians
-        const float G = G_MPS2;
-
-        // --- 1. Find the Exact Time of Impact (T_impact) ---
-        // Solve: 0 = H0_Meters + (V0*sin(Theta))*t - (0.5*G)*t^2
-        float A = 0.5f * G;
-        float B = V0 * sinf(Theta);
-        float C = H0_Meters;
-
-        float discriminant = B * B + 4.0f * A * C;
-        float T_impact = 0.0f;
-        if (discriminant >= 0.0f && std::abs(A) > 1e-9f) {
-            T_impact = (B + sqrtf(discriminant)) / (2.0f * A);
-        }
-
-        // --- 2. Set Max Simulation Time ---
-        float T_max = std::min((float)g_SimulationDuration, T_impact > 0.0f ? T_impact : (float)g_SimulationDuration);
-
-        for (int i = 0; i < num_path_samples; ++i) {
-            float t = T_max * (float(i) / (num_path_samples - 1));
-
-            float x = V0 * cosf(Theta) * t;
-            float y = H0_Meters + V0 * sinf(Theta) * t - 0.5f * G * t * t;
+        TrajectorySource source;
+        source.params.v0 = V0_MPS;
+        source.params.theta = THETA_DEG * (float)M_PI / 180.0f; // Convert to radians
+        source.params.h0 = H0_Meters;
+        source.params.g = G_MPS2;
+        source.drag = (g_DragModel != 0);
+        if (source.drag) source.integrator = MakeIntegratorOptions();
+        source.maxTime = (float)g_SimulationDuration;
+
+        // Sampled up to impact (last point snapped to the ground) or the simulation duration
+        SamplePolicy policy;
+        policy.kind = (SamplePolicy::Kind)path_sample_policy;
+        policy.count = num_path_samples;
+        policy.pxPerMeter = path_sample_scale;
+        policy.maxPixelError = max_path_error_px;
+
+        const unsigned generation = ++g_PathGeneration;
+        g_PathJob.cancel();
+        g_PathJob = pathJobs->submit([source, policy, generation](JobControl& control) {
+            ARCANE_PROFILE_SCOPE("Sample path");
+            PathSnapshot& next = g_PathBuffer.back();
+            g_Sampler.sample(source, policy, next.path);
+            if (control.cancelled()) return;
+            next.dragStats = source.drag ? g_Sampler.integratorStats() : IntegratorStats();
+            next.pathSeries.assign(next.path.x.data(), next.path.y.data(), next.path.count);
+            next.speedSeries.assign(next.path.t.data(), next.path.speed.data(), next.path.count);
+            next.generation = generation;
+            g_PathBuffer.publish();
+        });
+        if (waitForPaths) g_PathJob.wait();
+        return generation;
+    };
 
-            g_PathX.push_back(x);
-            g_PathY.push_back(y);
-        }
+    // Scenario handed in from outside (headless export): show its path and plots
+    if (hasScenario) {
+        hasScenario = false;
+        V0_MPS = scenario.v0;
+        THETA_DEG = scenario.thetaDeg;
+        H0_Meters = scenario.h0;
+        G_MPS2 = scenario.g;
+        CalculatePath(); // waited for: export frames must show this scenario, not the last one
+        g_ShowPlots = true;
+        g_FitVelocityPlot = true;
+        g_IsAnimationRunning = false;
+        g_RunGeneration = 0;
+    }
 
-        // If it hit within duration, snap last point to ground
-        if (T_impact > 0.0f && T_impact <= g_SimulationDuration) {
-            if (!g_PathY.empty()) g_PathY.back() = 0.0f;
-        }
-    };
+    // Results the worker published since the last frame
+    if (g_PathBuffer.update() && g_RunGeneration != 0 &&
+        g_PathBuffer.front().generation >= g_RunGeneration) {
+        g_RunGeneration = 0;
+        g_FitVelocityPlot = true;
+        g_IsAnimationRunning = true;
+        g_Clock.start(glfwGetTime());
+        g_PathBuffer.front().path.positionAt(0.0f, g_FireballCurr.x, g_FireballCurr.y);
+        g_FireballCurr.t = 0.0f;
+        g_FireballPrev = g_FireballCurr;
+    }
+    PathSnapshot& shown = g_PathBuffer.front();
+    if (g_McBuffer.update()) g_McValid = true;
+    const MonteCarloResult& mc = g_McBuffer.front();
 
     if (this->customFont)
         ImGui::PushFont(this->customFont);
@@ -239,8 +562,10 @@ void GUIRender::Update(GLFWwindow* window) {
                 ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
                 ImGui::InputFloat(label, value);
                 ImGui::SameLine();
-                std::string checkbox_label = std::string("##") + label + "_check";
-                ImGui::Checkbox(checkbox_label.c_str(), checked);
+                // Scoped ID instead of building "##label_check" every frame
+                ImGui::PushID(label);
+                ImGui::Checkbox("##check", checked);
+                ImGui::PopID();
             };
 
             ImGui::Columns(2, "InputCols");
@@ -265,6 +590,154 @@ void GUIRender::Update(GLFWwindow* window) {
                 ImGui::SliderFloat("Scale", &g_ScalePxPerMeter, 1.0f, 200.0f);
             }
 
+            // Drag switches the path, plots and animation to the numerical integrator
+            static const char* DRAG_MODELS[] = { "No drag", "Linear drag", "Quadratic drag" };
+            static const char* INTEGRATORS[] = { "RK4", "Dormand-Prince" };
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+            ImGui::Combo("##drag", &g_DragModel, DRAG_MODELS, 3);
+            if (g_DragModel != 0) {
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+                ImGui::SliderFloat("k", &g_DragCoeff, 0.0f, g_DragModel == 1 ? 2.0f : 0.1f, "%.4f");
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+                ImGui::Combo("Integrator", &g_IntegratorMethod, INTEGRATORS, 2);
+                ImGui::SameLine();
+                // Plain RK4 has no error estimate; 0 would read as exact
+                if (shown.dragStats.errorEstimated) {
+                    ImGui::Text("(%zu steps, err %.1e)", shown.dragStats.steps, shown.dragStats.maxLocalError);
+                } else {
+                    ImGui::Text("(%zu steps)", shown.dragStats.steps);
+                }
+            }
+
+            // Path sampling; the pixel bound follows the simulation view scale
+            static const char* SAMPLE_POLICIES[] = { "Uniform time", "Arc length", "Pixel error" };
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+            bool resample = ImGui::Combo("##sampling", &path_sample_policy, SAMPLE_POLICIES, 3);
+            ImGui::SameLine();
+            if (path_sample_policy == 2) {
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+                resample |= ImGui::SliderFloat("max px", &max_path_error_px, 0.1f, 5.0f, "%.2f");
+                ImGui::SameLine();
+                ImGui::Text("(%zu pts)", shown.path.count);
+            } else {
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+                if (ImGui::InputInt("points", &num_path_samples, 100, 100000, ImGuiInputTextFlags_EnterReturnsTrue)) {
+                    num_path_samples = std::min(std::max(num_path_samples, 2), 4000000);
+                    resample = true;
+                }
+            }
+            if (resample && shown.path.count > 0) CalculatePath();
+
+            // Plots draw at most a few points per pixel of width, however long the series
+            static const char* DECIMATIONS[] = { "Plot every point", "Plot min/max", "Plot LTTB" };
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+            ImGui::Combo("##decimation", &plot_decimation, DECIMATIONS, 3);
+
+            // Playback of the fixed-step animation
+            if (ImGui::Button(g_Clock.paused() ? "Resume" : "Pause")) g_Clock.setPaused(!g_Clock.paused(), glfwGetTime());
+            ImGui::SameLine();
+            if (ImGui::Button("Step") && g_Clock.paused()) g_Clock.stepOnce();
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+            ImGui::SliderFloat("speed", &g_PlaybackSpeed, 0.1f, 4.0f, "%.2fx");
+
+            ImGui::Checkbox("Render on demand", &renderOnDemand);
+#ifdef ARCANE_ENABLE_PROFILING
+            ImGui::SameLine();
+            ImGui::Checkbox("Profiler", &g_ShowProfiler);
+#endif
+            // Memoize solves: re-running unchanged inputs skips the solver
+            ImGui::Checkbox("Cache solves", &g_UseSolveCache);
+            ImGui::SameLine();
+            ImGui::Text("(%zu hits / %zu misses)", g_SolveCache.hits(), g_SolveCache.misses());
+
+            // Landing spread and a 5-95% height band over the path plot
+            if (ImGui::CollapsingHeader("Uncertainty (Monte Carlo)")) {
+                static const char* MC_KINDS[] = { "Normal", "Uniform", "Empirical" };
+                auto DrawMcInput = [](const char* label, McInput& input) {
+                    ImGui::PushID(label);
+                    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.25f);
+                    ImGui::Combo(label, &input.kind, MC_KINDS, 3);
+                    ImGui::SameLine();
+                    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.5f);
+                    if (input.kind == 0) {
+                        ImGui::InputFloat("sigma", &input.sigma);
+                    } else if (input.kind == 1) {
+                        ImGui::InputFloat2("bounds", input.bounds);
+                    } else {
+                        ImGui::InputText("##path", input.path, sizeof(input.path));
+                        ImGui::SameLine();
+                        if (ImGui::Button("Load") && !input.empirical.loadEmpirical(input.path)) {
+                            std::cerr << "Warning: no values read from " << input.path << std::endl;
+                        }
+                        ImGui::SameLine();
+                        // Until a file loads the input stays at its current value
+                        if (input.empirical.kind == InputDistribution::Empirical) {
+                            ImGui::Text("(%zu values)", input.empirical.values.size());
+                        } else {
+                            ImGui::TextUnformatted("(fixed)");
+                        }
+                    }
+                    ImGui::PopID();
+                };
+                auto McDistribution = [](const McInput& input, float value) {
+                    if (input.kind == 1) {
+                        return InputDistribution::uniform(std::min(input.bounds[0], input.bounds[1]),
+                                                          std::max(input.bounds[0], input.bounds[1]));
+                    }
+                    if (input.kind == 2) {
+                        if (input.empirical.kind == InputDistribution::Empirical) return input.empirical;
+                        return InputDistribution::fixed(value);
+                    }
+                    return InputDistribution::normal(value, std::max(input.sigma, 0.0f));
+                };
+                DrawMcInput("v (m/s)", g_McInputs[0]);
+                DrawMcInput("theta (deg)", g_McInputs[1]);
+                DrawMcInput("height (m)", g_McInputs[2]);
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.4f);
+                ImGui::SliderInt("samples", &g_McSamples, 1000, 2000000);
+
+                if (ImGui::Button("Run Monte Carlo")) {
+                    MonteCarloConfig config;
+                    config.vi = McDistribution(g_McInputs[0], V0_MPS);
+                    config.theta = McDistribution(g_McInputs[1], THETA_DEG);
+                    config.h0 = McDistribution(g_McInputs[2], H0_Meters);
+                    config.gravity = InputDistribution::fixed(G_MPS2);
+                    config.samples = (size_t)std::max(g_McSamples, 1);
+                    g_McJob.cancel();
+                    g_McJob = mcJobs->submit([config](JobControl& control) mutable {
+                        config.onProgress = [&control](size_t done, size_t total) {
+                            control.setProgress((float)done / (float)total);
+                            return !control.cancelled();
+                        };
+                        MonteCarloResult result = runMonteCarlo(config);
+                        if (control.cancelled()) return;
+                        g_McBuffer.back() = std::move(result);
+                        g_McBuffer.publish();
+                    });
+                    g_ShowPlots = true;
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Clear")) g_McValid = false;
+
+                if (!g_McJob.done()) {
+                    ImGui::ProgressBar(g_McJob.progress(), ImVec2(ImGui::GetContentRegionAvail().x * 0.6f, 0));
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancel")) g_McJob.cancel();
+                }
+                if (g_McValid) {
+                    ImGui::Text("Landing d: %.2f / %.2f / %.2f m (5/50/95%%)",
+                                mc.distance.quantile(0.05), mc.distance.quantile(0.5),
+                                mc.distance.quantile(0.95));
+                    ImGui::Text("Flight time: %.2f / %.2f / %.2f s",
+                                mc.time.quantile(0.05), mc.time.quantile(0.5),
+                                mc.time.quantile(0.95));
+                    ImGui::Text("%zu samples in %.2f s (%zu did not land)",
+                                mc.samples, mc.seconds, mc.unsolved);
+                }
+            }
+
             if(ImGui::Button("Run", ImVec2(-1, 0))){
                 float values[8];
                 bool isValid[8];
@@ -279,9 +752,15 @@ void GUIRender::Update(GLFWwindow* window) {
                 values[7] = time_val;            isValid[7] = time_checked;
                 
                 // pass arrays into Arcane Math to solve for the unknown values
-                ArcaneMath newValues(values, isValid);
-                newValues.solve();
-                newValues.writeToArray(values);
+                // (closed form, so it stays on this thread; sampling does not)
+                ARCANE_PROFILE_SCOPE("Solve");
+                if (g_UseSolveCache) {
+                    g_SolveCache.solve(values, isValid);
+                } else {
+                    ArcaneMath newValues(values, isValid);
+                    newValues.solve();
+                    newValues.writeToArray(values);
+                }
 
                 // Update the UI static variables with the newly computed values
                 // Order: [0]=gravity, [1]=yi (height), [2]=yf (finalHeight), [3]=vi (initialV),
@@ -295,64 +774,45 @@ void GUIRender::Update(GLFWwindow* window) {
                 theta_val = values[6];
                 time_val = values[7];
 
-                // Generate trajectory data for plotting
-                // Convert theta back to radians for calculations
-                const float PI = 3.14159265358979323846f;
-                float theta_rad = theta_val * PI / 180.0f;
-                
-                plot_data_count = 0;
-                plot_v_count = 0;
-                float dt = time_val / 50.0f; // 50 points along the trajectory
-                if (dt > 0.0f && time_val > 0.0f) {
-                    for (int i = 0; i <= 50 && plot_data_count < 100; i++) {
-                        float t = i * dt;
-                        float x = initialVelocity_val * std::cos(theta_rad) * t;
-                        float y = height_val + initialVelocity_val * std::sin(theta_rad) * t 
-                                - 0.5f * gravity_val * t * t;
-                        plot_x_data[plot_data_count] = x;
-                        plot_y_data[plot_data_count] = std::max(y, 0.0f); // Clamp to ground
-                        
-                        // Compute velocity at this time
-                        float vx = initialVelocity_val * std::cos(theta_rad);
-                        float vy = initialVelocity_val * std::sin(theta_rad) - gravity_val * t;
-                        float v_magnitude = std::sqrt(vx*vx + vy*vy);
-                        
-                        plot_t_data[plot_v_count] = t;
-                        plot_v_data[plot_v_count] = v_magnitude;
-                        
-                        plot_data_count++;
-                        plot_v_count++;
-                    }
-                }
-
                 // Update shared simulation parameters so animation follows solved values
                 V0_MPS = initialVelocity_val;
                 THETA_DEG = theta_val;
                 H0_Meters = height_val;
                 G_MPS2 = gravity_val;
 
-                // Recompute the path for the simulation window
-                CalculatePath();
-
+                // Sample the solved path once for the plots and the simulation window;
+                // the animation starts when it is published
+                g_RunGeneration = CalculatePath();
                 g_ShowPlots = true; 
-                g_IsAnimationRunning = true;
-                g_TimeStart = glfwGetTime();
+            }
+
+            if (!g_PathJob.done()) {
+                ImGui::ProgressBar(-1.0f * (float)glfwGetTime(), ImVec2(ImGui::GetContentRegionAvail().x * 0.6f, 0), "Sampling path");
+                ImGui::SameLine();
+                if (ImGui::Button("Cancel##path")) {
+                    g_PathJob.cancel();
+                    g_RunGeneration = 0;
+                }
             }
         }
         ImGui::EndChild();
 
         if (g_ShowPlots) {
+            ARCANE_PROFILE_SCOPE("Plots");
             // Position V Time Graph (2/3 section of slice)
             float xmin=0.0f, xmax=0.0f, ymin=0.0f, ymax=0.0f;
             float xpad = 0.0f, ypad = 0.0f;
+            const int plot_data_count = (int)shown.path.count;
             if (plot_data_count > 0) {
-                xmin = plot_x_data[0]; xmax = plot_x_data[0];
-                ymin = plot_y_data[0]; ymax = plot_y_data[0];
-                for (int i = 1; i < plot_data_count; ++i) {
-                    xmin = std::min(xmin, plot_x_data[i]);
-                    xmax = std::max(xmax, plot_x_data[i]);
-                    ymin = std::min(ymin, plot_y_data[i]);
-                    ymax = std::max(ymax, plot_y_data[i]);
+                xmin = shown.pathSeries.xMin(); xmax = shown.pathSeries.xMax();
+                ymin = shown.pathSeries.yMin(); ymax = shown.pathSeries.yMax();
+                // Keep the Monte Carlo band inside the fitted limits
+                if (g_McValid) {
+                    for (size_t i = 0; i < mc.bandX.size(); ++i) {
+                        xmax = std::max(xmax, mc.bandX[i]);
+                        ymin = std::min(ymin, mc.bandLow[i]);
+                        ymax = std::max(ymax, mc.bandHigh[i]);
+                    }
                 }
                 xpad = (xmax - xmin) * 0.1f;
                 if (xpad < 1e-3f) xpad = std::max(1.0f, (ymax - ymin) * 0.1f);
@@ -399,16 +859,34 @@ void GUIRender::Update(GLFWwindow* window) {
                 }
 
                 ImPlot::SetupAxes("Distance (m)", "Height (m)"); 
+                if (g_McValid && !mc.bandX.empty()) {
+                    int band_count = (int)mc.bandX.size();
+                    ImPlot::SetNextFillStyle(ImVec4(1.0f, 0.55f, 0.0f, 1.0f), 0.3f);
+                    ImPlot::PlotShaded("5-95%", mc.bandX.data(), mc.bandLow.data(),
+                                       mc.bandHigh.data(), band_count);
+                    ImPlot::SetNextLineStyle(ImVec4(1.0f, 0.55f, 0.0f, 1.0f), 1.0f);
+                    ImPlot::PlotLine("Median", mc.bandX.data(), mc.bandMid.data(), band_count);
+                }
                 if (plot_data_count > 0) {
-                    ImPlot::PlotLine("Path", plot_x_data, plot_y_data, plot_data_count);
+                    ImPlotRect limits = ImPlot::GetPlotLimits();
+                    PlotView path = shown.pathSeries.view(limits.X.Min, limits.X.Max, (int)ImPlot::GetPlotSize().x,
+                                                      (Decimation)plot_decimation);
+                    ImPlot::PlotLine("Path", path.x, path.y, path.count);
                 }
                 ImPlot::EndPlot();
             }
     
+            if (g_FitVelocityPlot) {
+                ImPlot::SetNextAxesToFit();
+                g_FitVelocityPlot = false;
+            }
             if (ImPlot::BeginPlot("Velocity vs Time", ImVec2(-1, -1), ImPlotFlags_NoLegend)) { 
                 ImPlot::SetupAxes("Time (s)", "Velocity (m/s)"); 
-                if (plot_v_count > 0) {
-                    ImPlot::PlotLine("Velocity", plot_t_data, plot_v_data, plot_v_count);
+                if (plot_data_count > 0) {
+                    ImPlotRect limits = ImPlot::GetPlotLimits();
+                    PlotView speed = shown.speedSeries.view(limits.X.Min, limits.X.Max, (int)ImPlot::GetPlotSize().x,
+                                                        (Decimation)plot_decimation);
+                    ImPlot::PlotLine("Velocity", speed.x, speed.y, speed.count);
                 }
                 ImPlot::EndPlot();
             }
@@ -432,35 +910,34 @@ void GUIRender::Update(GLFWwindow* window) {
         ImGuiWindowFlags_NoBackground;
 
     if (ImGui::Begin("SimulationWindow", nullptr, sim_flags)) {
+        ARCANE_PROFILE_SCOPE("Simulation draw list");
 
         ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
         ImVec2 canvas_size = ImGui::GetContentRegionAvail();
         ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
-        // Sky
-        draw_list->AddRectFilled(
-            canvas_pos,
-            ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
-            IM_COL32(135, 206, 235, 255)
-        );
-
         float shooter_base_y = canvas_pos.y + canvas_size.y - GROUND_HEIGHT;
 
-        // Ground
-        draw_list->AddRectFilled(
-            ImVec2(canvas_pos.x, shooter_base_y),
-            ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
-            IM_COL32(50,40,30,255)
-        );
-
-        // (Shooter will be drawn after we compute the px-per-meter scale so its
-        // displayed height matches the world initial height `H0_Meters`.)
-
-        double current_time = glfwGetTime();
+        // (Sky, ground and shooter are drawn after we compute the px-per-meter
+        // scale so the shooter's height matches the world initial height `H0_Meters`.)
 
+        // Step the fireball at the fixed dt, however long this frame took
         float t = 0.0f;
+        FireballState fireball = { 0.0f, 0.0f, 0.0f };
         if (g_IsAnimationRunning) {
-            t = (float)(current_time - g_TimeStart);
+            g_Clock.setTimeScale(g_PlaybackSpeed);
+            int steps = g_Clock.advance(glfwGetTime());
+            for (int i = 0; i < steps; ++i) {
+                g_FireballPrev = g_FireballCurr;
+                g_FireballCurr.t += (float)g_Clock.stepSize();
+                shown.path.positionAt(g_FireballCurr.t, g_FireballCurr.x, g_FireballCurr.y);
+            }
+            float alpha = (float)g_Clock.alpha();
+            fireball.t = g_FireballPrev.t + (g_FireballCurr.t - g_FireballPrev.t) * alpha;
+            fireball.x = g_FireballPrev.x + (g_FireballCurr.x - g_FireballPrev.x) * alpha;
+            fireball.y = g_FireballPrev.y + (g_FireballCurr.y - g_FireballPrev.y) * alpha;
+
+            t = fireball.t;
             if (t >= g_SimulationDuration) {
                 t = g_SimulationDuration;
                 g_IsAnimationRunning = false;
@@ -503,6 +980,14 @@ void GUIRender::Update(GLFWwindow* window) {
         }
     }
 
+    // The pixel-error bound holds only for the scale the path was sampled at:
+    // resample on zoom in, and on zoom out once it is twice as fine as needed
+    if (path_sample_policy == 2 && shown.path.count > 0 &&
+        (scale_px_per_meter > path_sample_scale * 1.001f || scale_px_per_meter < path_sample_scale * 0.5f)) {
+        path_sample_scale = scale_px_per_meter;
+        CalculatePath();
+    }
+
     float shooter_base_x = canvas_pos.x + SHOOTER_OFFSET;
     // Compute shooter height in pixels from world units so the block visibly
     // represents the initial height `H0_Meters`.
@@ -511,21 +996,73 @@ void GUIRender::Update(GLFWwindow* window) {
     if (shooter_height_px > max_shooter_height_px) shooter_height_px = max_shooter_height_px;
     if (shooter_height_px < 0.0f) shooter_height_px = 0.0f;
 
-    float shooter_top_y = shooter_base_y - shooter_height_px;
-    draw_list->AddRectFilled(
-        ImVec2(shooter_base_x, shooter_top_y),
-        ImVec2(shooter_base_x + SHOOTER_WIDTH, shooter_base_y),
-        IM_COL32(70,0,100,255)
-    );
+    // Static layers, in canvas coordinates: they only change with the canvas
+    // size, the scale and H0, so they are drawn into the layer cache's texture
+    // when one of those changes and composited as a single quad otherwise
+    auto DrawStaticLayers = [&](ImDrawList* layer, ImVec2 origin) {
+        float base_y = origin.y + canvas_size.y - GROUND_HEIGHT;
+        // Sky
+        layer->AddRectFilled(
+            origin,
+            ImVec2(origin.x + canvas_size.x, origin.y + canvas_size.y),
+            IM_COL32(135, 206, 235, 255)
+        );
+        // Ground
+        layer->AddRectFilled(
+            ImVec2(origin.x, base_y),
+            ImVec2(origin.x + canvas_size.x, origin.y + canvas_size.y),
+            IM_COL32(50,40,30,255)
+        );
+        // Shooter
+        float base_x = origin.x + SHOOTER_OFFSET;
+        layer->AddRectFilled(
+            ImVec2(base_x, base_y - shooter_height_px),
+            ImVec2(base_x + SHOOTER_WIDTH, base_y),
+            IM_COL32(70,0,100,255)
+        );
+    };
+    {
+        ARCANE_PROFILE_SCOPE("Static layers");
+        const ImVec2 fb_scale = ImGui::GetIO().DisplayFramebufferScale;
+        LayerKey key;
+        key.width = (int)(canvas_size.x * fb_scale.x + 0.5f);
+        key.height = (int)(canvas_size.y * fb_scale.y + 0.5f);
+        key.scale = scale_px_per_meter;
+        key.h0 = H0_Meters;
+        if (ImDrawList* layer = sceneLayers.begin(key, canvas_size)) {
+            DrawStaticLayers(layer, ImVec2(0.0f, 0.0f));
+            sceneLayers.end();
+        }
+        if (sceneLayers.valid()) {
+            sceneLayers.composite(draw_list, canvas_pos, canvas_size);
+        } else {
+            DrawStaticLayers(draw_list, canvas_pos); // no framebuffer: draw every frame
+        }
+    }
 
     ImVec2 ground_origin_pix(
         shooter_base_x + SHOOTER_WIDTH / 2.0f,
         shooter_base_y                        
     );
 
-    // Fireball position calculation (y_m includes H0_Meters)
-    float x_m = V0 * cosf(Theta) * t;
-    float y_m = H0_Meters + V0 * sinf(Theta) * t - 0.5f * G * t * t;
+    // Path trace: one vertex per sample, so the vertex count follows the sampling
+    // (dense uniform paths are cut down to the canvas width like the plots)
+    if (g_ShowPlots && shown.path.count > 1) {
+        PlotView trace = shown.pathSeries.view((canvas_pos.x - ground_origin_pix.x) / scale_px_per_meter,
+                                           (canvas_pos.x + canvas_size.x - ground_origin_pix.x) / scale_px_per_meter,
+                                           (int)canvas_size.x, Decimation::MinMax);
+        ImVec2* path_points_pix = FrameArena::instance().array<ImVec2>(trace.count);
+        for (int i = 0; i < trace.count; ++i) {
+            path_points_pix[i] = ImVec2(ground_origin_pix.x + trace.x[i] * scale_px_per_meter,
+                                        ground_origin_pix.y - trace.y[i] * scale_px_per_meter);
+        }
+        draw_list->AddPolyline(path_points_pix, trace.count, IM_COL32(255,120,0,160),
+                               0, path_line_thickness_px);
+    }
+
+    // Fireball steps along the sampled path (y_m includes H0_Meters), so it
+    // moves along exactly the curve that is plotted and holds at impact
+    float x_m = fireball.x, y_m = fireball.y;
 
     float x_pix = ground_origin_pix.x + x_m * scale_px_per_meter;
     float y_pix = ground_origin_pix.y - y_m * scale_px_per_meter; 
@@ -558,23 +1095,44 @@ void GUIRender::Update(GLFWwindow* window) {
 
         ImGui::SetCursorScreenPos(ImVec2(canvas_pos.x + 10, canvas_pos.y + 10));
         ImGui::Text("Time: %.2f / %.2f", t, (float)g_SimulationDuration);
+        ImGui::Text("Steps: %lld x %.2f ms, %.2f s dropped", g_Clock.steps(), g_Clock.stepSize() * 1000.0,
+                    g_Clock.droppedSeconds());
         ImGui::Text("Position: X=%.2f m, Y=%.2f m", x_m, y_m);
         ImGui::Text("Scale: %.2f px/m", scale_px_per_meter);
+        ImGui::Text("%.1f fps, %.1f%% idle, CPU %.1f%%", framesPerSecond, idlePercent, cpuPercent);
     }
 
     ImGui::End();
 
+    // Keep drawing while the fireball is in flight; otherwise sleep until input
+    if (g_IsAnimationRunning && !g_Clock.paused()) RequestRedraw(SETTLE_FRAMES);
+    // Progress bars move while jobs run; a worker wakes us when one ends
+    if (!g_PathJob.done() || !g_McJob.done()) RequestRedraw(1);
+
+#ifdef ARCANE_ENABLE_PROFILING
+    if (g_ShowProfiler) DrawProfilerWindow(&g_ShowProfiler);
+#endif
+
     if (this->customFont)
         ImGui::PopFont();
 }
 
 
 void GUIRender::Render() {
-    ImGui::Render();
+    {
+        ARCANE_PROFILE_SCOPE("ImGui::Render");
+        ImGui::Render();
+    }
+    ARCANE_PROFILE_SCOPE("RenderDrawData");
+    ARCANE_GPU_SCOPE("ImGui draw");
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 void GUIRender::Shutdown() {
+    // Cancel and join before the window goes away
+    mcJobs.reset();
+    pathJobs.reset();
+    sceneLayers.destroy();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImPlot::DestroyContext();
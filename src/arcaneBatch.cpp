@@ -0,0 +1,380 @@
+#include "../include/ArcaneMath.h"
+#include "../include/ArcaneIO.h"
+#include "../include/ArcaneScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Headless batch solver: reads scenarios as CSV or JSON lines, solves them in
+// fixed-size chunks with ArcaneMath<T>::solveBatch (slices of a chunk solved in
+// parallel on the shared TaskScheduler) and streams the results out.
+//
+// CSV: an optional header naming the columns (gravity, yi, yf, vi, vf, d,
+// theta, time, in any order); without one the columns are taken in that
+// order. A blank cell is an unknown.
+// JSONL: one object per line, e.g. {"theta": 45, "vi": 20}; missing keys or
+// null are unknowns.
+// Output uses the input format with every value plus a "solved" flag; values
+// that could not be determined are left blank (CSV) or null (JSONL).
+
+namespace {
+
+const char* const COLUMN_NAMES[8] = { "gravity", "yi", "yf", "vi", "vf", "d", "theta", "time" };
+const size_t MAX_ROW_TEXT = 512; // upper bound for one formatted output row
+const int MAX_WARNINGS = 10;
+// Smallest slice of a chunk handed to one worker
+const size_t SOLVE_GRAIN = 2048;
+
+enum class Format { Auto, Csv, Jsonl };
+
+struct Options {
+    const char* input = nullptr;  // nullptr = stdin
+    const char* output = nullptr; // nullptr = stdout
+    Format format = Format::Auto;
+    bool useDouble = false;
+    size_t chunkRows = 65536;
+    SchedulerOptions pool;
+};
+
+void printUsage() {
+    std::cerr << "usage: arcaneBatch [options] [input|-]\n"
+              << "  -o, --output FILE      write results to FILE (default stdout)\n"
+              << "  -f, --format csv|jsonl input/output format (default: detect)\n"
+              << "  -p, --precision float|double  solver precision (default float)\n"
+              << "  -c, --chunk N          scenarios solved per chunk (default 65536)\n"
+              << "  -j, --threads N        solver threads (default: all cores)\n"
+              << "  --pin                  pin solver threads to cores\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+
+        if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+            return false;
+        } else if (!std::strcmp(arg, "-o") || !std::strcmp(arg, "--output")) {
+            options.output = value();
+            if (!options.output) return false;
+        } else if (!std::strcmp(arg, "-f") || !std::strcmp(arg, "--format")) {
+            const char* v = value();
+            if (v && !std::strcmp(v, "csv")) options.format = Format::Csv;
+            else if (v && !std::strcmp(v, "jsonl")) options.format = Format::Jsonl;
+            else return false;
+        } else if (!std::strcmp(arg, "-p") || !std::strcmp(arg, "--precision")) {
+            const char* v = value();
+            if (v && !std::strcmp(v, "float")) options.useDouble = false;
+            else if (v && !std::strcmp(v, "double")) options.useDouble = true;
+            else return false;
+        } else if (!std::strcmp(arg, "-c") || !std::strcmp(arg, "--chunk")) {
+            const char* v = value();
+            long rows = v ? std::atol(v) : 0;
+            if (rows <= 0) return false;
+            options.chunkRows = (size_t)rows;
+        } else if (!std::strcmp(arg, "-j") || !std::strcmp(arg, "--threads")) {
+            const char* v = value();
+            long threads = v ? std::atol(v) : 0;
+            if (threads <= 0) return false;
+            options.pool.threads = (unsigned)threads;
+        } else if (!std::strcmp(arg, "--pin")) {
+            options.pool.pinThreads = true;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            return false;
+        } else {
+            options.input = arg;
+        }
+    }
+    return true;
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+int columnIndex(const char* name, size_t length) {
+    for (int k = 0; k < 8; k++) {
+        if (std::strlen(COLUMN_NAMES[k]) == length && !std::memcmp(COLUMN_NAMES[k], name, length)) return k;
+    }
+    return -1;
+}
+
+template <typename T>
+class BatchJob {
+    public:
+        BatchJob(const Options& options, ArcaneWriter& writer)
+            : format(options.format), chunkRows(options.chunkRows), writer(writer) {
+            for (auto& column : columns) column.resize(chunkRows);
+            known.resize(chunkRows);
+            for (int k = 0; k < 8; k++) csvColumns[k] = k;
+        }
+
+        // Parse a run of whole lines, solving and writing every full chunk
+        void consume(const char* begin, const char* end) {
+            while (begin < end) {
+                const char* nl = static_cast<const char*>(std::memchr(begin, '\n', (size_t)(end - begin)));
+                const char* lineEnd = nl ? nl : end;
+                lineNumber++;
+                parseLine(begin, lineEnd);
+                if (rows == chunkRows) flushChunk();
+                begin = nl ? nl + 1 : end;
+            }
+        }
+
+        void finish() {
+            flushChunk();
+            writer.flush();
+        }
+
+        size_t totalRows = 0;
+        size_t solvedRows = 0;
+        size_t malformedLines = 0;
+
+    private:
+        void warn(const char* what) {
+            malformedLines++;
+            if (malformedLines <= (size_t)MAX_WARNINGS) {
+                std::cerr << "Warning: line " << lineNumber << ": " << what << "\n";
+            }
+        }
+
+        void parseLine(const char* begin, const char* end) {
+            while (begin < end && isBlank(*begin)) begin++;
+            while (end > begin && isBlank(end[-1])) end--;
+            if (begin == end || *begin == '#') return;
+
+            if (format == Format::Auto) format = (*begin == '{') ? Format::Jsonl : Format::Csv;
+            if (format == Format::Jsonl) parseJsonLine(begin, end);
+            else parseCsvLine(begin, end);
+        }
+
+        void startRow() {
+            for (auto& column : columns) column[rows] = T(0);
+            known[rows] = 0;
+        }
+
+        void parseCsvLine(const char* begin, const char* end) {
+            if (!sawFirstCsvLine) {
+                sawFirstCsvLine = true;
+                if (readCsvHeader(begin, end)) return;
+            }
+
+            startRow();
+            int field = 0;
+            bool ok = true;
+            const char* p = begin;
+            while (true) {
+                while (p < end && isBlank(*p)) p++;
+                int target = (field < 8) ? csvColumns[field] : -1;
+                if (p < end && *p != ',') {
+                    double value;
+                    if (parseNumber(p, end, value)) {
+                        while (p < end && isBlank(*p)) p++;
+                        if (target >= 0) {
+                            columns[target][rows] = (T)value;
+                            known[rows] |= (unsigned char)(1u << target);
+                        }
+                    }
+                    if (p < end && *p != ',') {
+                        ok = false;
+                        while (p < end && *p != ',') p++;
+                    }
+                }
+                field++;
+                if (p >= end) break;
+                p++; // comma
+            }
+            if (!ok) warn("unreadable number treated as unknown");
+            rows++;
+        }
+
+        // A first line with any non-numeric cell names the columns
+        bool readCsvHeader(const char* begin, const char* end) {
+            bool header = false;
+            for (const char* p = begin; p < end; p++) {
+                if ((*p >= 'a' && *p <= 'z' && *p != 'e') || (*p >= 'A' && *p <= 'Z' && *p != 'E') || *p == '_') {
+                    header = true;
+                    break;
+                }
+            }
+            if (!header) return false;
+
+            int field = 0;
+            const char* p = begin;
+            while (p <= end && field < 8) {
+                const char* cell = p;
+                while (p < end && *p != ',') p++;
+                const char* cellEnd = p;
+                while (cell < cellEnd && (isBlank(*cell) || *cell == '"')) cell++;
+                while (cellEnd > cell && (isBlank(cellEnd[-1]) || cellEnd[-1] == '"')) cellEnd--;
+                csvColumns[field] = columnIndex(cell, (size_t)(cellEnd - cell));
+                if (csvColumns[field] < 0) {
+                    std::cerr << "Warning: ignoring unknown column '"
+                              << std::string(cell, cellEnd) << "'\n";
+                }
+                field++;
+                p++;
+            }
+            for (; field < 8; field++) csvColumns[field] = -1;
+            return true;
+        }
+
+        void parseJsonLine(const char* begin, const char* end) {
+            startRow();
+            double values[8];
+            unsigned found;
+            bool ok = parseJsonFields(begin, end, COLUMN_NAMES, 8, values, found);
+            for (int k = 0; k < 8; k++) {
+                if (found & (1u << k)) columns[k][rows] = (T)values[k];
+            }
+            known[rows] = (unsigned char)found;
+            if (!ok) warn("malformed JSON field treated as unknown");
+            rows++;
+        }
+
+        void flushChunk() {
+            if (rows == 0) return;
+
+            // Rows are independent, so slices of the chunk solve in parallel
+            TaskScheduler::shared().parallelFor(0, rows, [&](size_t first, size_t last) {
+                ArcaneBatch<T> batch;
+                batch.gravity = columns[0].data() + first;
+                batch.yi = columns[1].data() + first;
+                batch.yf = columns[2].data() + first;
+                batch.vi = columns[3].data() + first;
+                batch.vf = columns[4].data() + first;
+                batch.d = columns[5].data() + first;
+                batch.theta = columns[6].data() + first;
+                batch.time = columns[7].data() + first;
+                batch.known = known.data() + first;
+                batch.count = last - first;
+                ArcaneMath<T>::solveBatch(batch);
+            }, SOLVE_GRAIN);
+
+            if (format == Format::Csv && !wroteHeader) {
+                const char header[] = "gravity,yi,yf,vi,vf,d,theta,time,solved\n";
+                writer.write(header, sizeof(header) - 1);
+                wroteHeader = true;
+            }
+            for (size_t i = 0; i < rows; i++) {
+                if (format == Format::Jsonl) writeJsonRow(i);
+                else writeCsvRow(i);
+                if (known[i] == KNOWN_ALL) solvedRows++;
+            }
+            totalRows += rows;
+            rows = 0;
+        }
+
+        void writeCsvRow(size_t i) {
+            char* out = writer.reserve(MAX_ROW_TEXT);
+            char* limit = out + MAX_ROW_TEXT;
+            for (int k = 0; k < 8; k++) {
+                if (k > 0) *out++ = ',';
+                if (known[i] & (1u << k)) {
+                    char* next = formatNumber(out, limit - 8, columns[k][i]);
+                    if (next) out = next;
+                }
+            }
+            const char* solved = (known[i] == KNOWN_ALL) ? ",1\n" : ",0\n";
+            std::memcpy(out, solved, 3);
+            writer.commit(out + 3);
+        }
+
+        void writeJsonRow(size_t i) {
+            char* out = writer.reserve(MAX_ROW_TEXT);
+            char* limit = out + MAX_ROW_TEXT;
+            *out++ = '{';
+            for (int k = 0; k < 8; k++) {
+                size_t length = std::strlen(COLUMN_NAMES[k]);
+                *out++ = '"';
+                std::memcpy(out, COLUMN_NAMES[k], length);
+                out += length;
+                *out++ = '"';
+                *out++ = ':';
+                char* next = nullptr;
+                if (known[i] & (1u << k)) next = formatNumber(out, limit - 32, columns[k][i]);
+                if (next) {
+                    out = next;
+                } else {
+                    std::memcpy(out, "null", 4);
+                    out += 4;
+                }
+                *out++ = ',';
+            }
+            const char* solved = (known[i] == KNOWN_ALL) ? "\"solved\":true}\n" : "\"solved\":false}\n";
+            size_t length = std::strlen(solved);
+            std::memcpy(out, solved, length);
+            writer.commit(out + length);
+        }
+
+        Format format;
+        size_t chunkRows;
+        ArcaneWriter& writer;
+
+        std::vector<T> columns[8];
+        std::vector<unsigned char> known;
+        size_t rows = 0;
+
+        int csvColumns[8]; // value index of each CSV field, -1 to skip
+        bool sawFirstCsvLine = false;
+        bool wroteHeader = false;
+        size_t lineNumber = 0;
+};
+
+template <typename T>
+int run(const Options& options, ArcaneLineReader& reader, FILE* out) {
+    auto start = std::chrono::steady_clock::now();
+
+    ArcaneWriter writer(out);
+    BatchJob<T> job(options, writer);
+    const char* begin;
+    const char* end;
+    while (reader.next(begin, end)) job.consume(begin, end);
+    job.finish();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "arcaneBatch: " << job.totalRows << " scenarios (" << job.solvedRows
+              << " fully solved) in " << seconds << " s";
+    if (seconds > 0.0) std::cerr << ", " << (size_t)(job.totalRows / seconds) << " scenarios/s";
+    std::cerr << (reader.isMapped() ? " [mapped input]" : " [streamed input]") << "\n";
+    if (job.malformedLines > 0) std::cerr << job.malformedLines << " malformed line(s)\n";
+
+    if (writer.failed()) {
+        std::cerr << "Error: failed writing output\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    TaskScheduler::configureShared(options.pool);
+
+    ArcaneLineReader reader;
+    if (!reader.open(options.input)) {
+        std::cerr << "Error: cannot open input '" << (options.input ? options.input : "stdin") << "'\n";
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (options.output) {
+        out = std::fopen(options.output, "wb");
+        if (!out) {
+            std::cerr << "Error: cannot open output '" << options.output << "'\n";
+            return 1;
+        }
+    }
+
+    int status = options.useDouble ? run<double>(options, reader, out)
+                                   : run<float>(options, reader, out);
+    if (out != stdout) std::fclose(out);
+    return status;
+}
@@ -5,10 +5,89 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
+#include "../include/ArcaneHeadless.h"
 #include "../include/GUIRender.h"
+#include "../include/ArcaneGpuTimer.h"
+#include "../include/ArcaneProfiler.h"
+#include "../include/ArcaneScheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
-int main() {
+namespace {
+
+void printUsage() {
+    std::cerr << "usage: ArcaneDynamics [--headless --scenarios FILE [options]]\n"
+              << "  --headless             render scenarios offscreen instead of opening a window\n"
+              << "  --scenarios FILE       one \"v0,theta,h0,g\" launch per line (theta in degrees)\n"
+              << "  -o, --output DIR       where frames go (default .)\n"
+              << "  --size WxH             frame size (default 640x360)\n"
+              << "  -f, --format png|raw   PNG per scenario, or one raw RGBA stream (default png)\n"
+              << "  -j, --threads N        worker threads (default: all cores)\n"
+              << "  --check-allocations    fail if steady-state frames allocate (implies --headless;\n"
+              << "                         needs ARCANE_TRACK_ALLOCATIONS, --scenarios optional)\n";
+}
+
+// Returns false on bad arguments; headless is set when --headless was given
+bool parseArgs(int argc, char** argv, bool& headless, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+
+        if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+            return false;
+        } else if (!std::strcmp(arg, "--headless")) {
+            headless = true;
+        } else if (!std::strcmp(arg, "--check-allocations")) {
+            headless = true;
+            options.checkAllocations = true;
+        } else if (!std::strcmp(arg, "--scenarios")) {
+            options.scenarioPath = value();
+            if (!options.scenarioPath) return false;
+        } else if (!std::strcmp(arg, "-o") || !std::strcmp(arg, "--output")) {
+            options.outDir = value();
+            if (!options.outDir) return false;
+        } else if (!std::strcmp(arg, "--size")) {
+            const char* v = value();
+            if (!v || std::sscanf(v, "%dx%d", &options.width, &options.height) != 2) return false;
+            if (options.width <= 0 || options.height <= 0) return false;
+        } else if (!std::strcmp(arg, "-f") || !std::strcmp(arg, "--format")) {
+            const char* v = value();
+            if (v && !std::strcmp(v, "png")) options.format = ExportFormat::Png;
+            else if (v && !std::strcmp(v, "raw")) options.format = ExportFormat::RawVideo;
+            else return false;
+        } else if (!std::strcmp(arg, "-j") || !std::strcmp(arg, "--threads")) {
+            const char* v = value();
+            long threads = v ? std::atol(v) : 0;
+            if (threads <= 0) return false;
+            options.threads = (unsigned)threads;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    if (!parseArgs(argc, argv, headless, headlessOptions)) {
+        printUsage();
+        return 1;
+    }
+
+    // Sampling, Monte Carlo and export share one pool; the window leaves a
+    // core to the frame loop
+    SchedulerOptions pool;
+    pool.threads = headless ? headlessOptions.threads : std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    TaskScheduler::configureShared(pool);
+    if (headless) return runHeadless(headlessOptions);
 
     // setup winder
     if(!glfwInit()) return 1;
@@ -36,17 +115,47 @@ int main() {
 
     GUIRender GUI;
     GUI.Init(window, glsl_version);
+#ifdef ARCANE_ENABLE_PROFILING
+    if (!GpuTimer::instance().init())
+        std::cerr << "Warning: no GL timer queries (needs GL 3.3), GPU pass times disabled" << std::endl;
+#endif
 
     while(!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        GUI.NewFrame();
-        GUI.Update(window);
-        GUI.Render();
-        glfwSwapBuffers(window);
+        // sleeps while nothing moves and no input arrives
+        {
+            ARCANE_PROFILE_SCOPE("Wait for events");
+            GUI.WaitForEvents();
+        }
+#ifdef ARCANE_ENABLE_PROFILING
+        GpuTimer::instance().beginFrame();
+#endif
+        {
+            ARCANE_GPU_SCOPE("Clear");
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        {
+            ARCANE_PROFILE_SCOPE("NewFrame");
+            GUI.NewFrame();
+        }
+        {
+            ARCANE_PROFILE_SCOPE("Update");
+            GUI.Update(window);
+        }
+        {
+            ARCANE_PROFILE_SCOPE("Render");
+            GUI.Render();
+        }
+        {
+            ARCANE_PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(window);
+        }
+        ARCANE_PROFILE_FRAME();
     }
 
+#ifdef ARCANE_ENABLE_PROFILING
+    GpuTimer::instance().shutdown();
+#endif
     GUI.Shutdown();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,450 @@
+#include "../include/ArcaneMath.h"
+#include "../include/ArcaneScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Solver benchmark: times ArcaneMath construction + solve() for every
+// known-mask over several input regimes and reports ns/scenario, fixed-point
+// iterations and throughput. --format csv|json gives machine-readable rows,
+// and --compare reads an earlier CSV run to show the change per regime.
+// --scaling N instead times solveBatch over N scenarios on a TaskScheduler
+// of 1, 2, ... -j workers and reports the speedup over one.
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const char* const VALUE_NAMES[8] = { "gravity", "yi", "yf", "vi", "vf", "d", "theta", "time" };
+
+enum class Format { Text, Csv, Json };
+
+struct Options {
+    size_t scenarios = 1000; // per regime and mask
+    int rounds = 5;          // timed passes; the fastest and median are reported
+    bool useDouble = false;
+    Format format = Format::Text;
+    const char* regime = nullptr; // run only this regime
+    const char* compare = nullptr;
+    size_t scaling = 0;      // scenarios per batch; 0 = the per-mask benchmark
+    unsigned maxThreads = 0; // scaling: up to this many workers (0 = all cores)
+    bool pinThreads = false;
+};
+
+// Known values of the scaling batch: launch state plus landing height, the
+// common "where does it land" query
+const unsigned SCALING_MASK = KNOWN_GRAVITY | KNOWN_YI | KNOWN_YF | KNOWN_VI | KNOWN_THETA;
+// Smallest slice of the batch one worker solves
+const size_t SCALING_GRAIN = 1024;
+
+// Launch parameters drawn for a regime. Each scenario is a consistent
+// trajectory: all 8 values are computed from these, then hidden per mask.
+struct Regime {
+    const char* name;
+    double yiMin, yiMax;
+    double viMin, viMax;
+    double thetaMin, thetaMax; // degrees
+    double timeFraction;       // of the flight until y returns to yi; 0 = zero time
+};
+
+const Regime REGIMES[] = {
+    { "typical",        0.0,  20.0,  5.0, 60.0, 10.0,   80.0,    1.0 },
+    { "theta-near-0",   0.0,  20.0,  5.0, 60.0, 0.0001, 0.5,     1.0 },
+    { "theta-near-90",  0.0,  20.0,  5.0, 60.0, 89.5,   89.9999, 1.0 },
+    { "zero-time",      0.0,  20.0,  5.0, 60.0, 10.0,   80.0,    0.0 },
+    { "negative-height", -50.0, -1.0, 5.0, 60.0, 10.0,  80.0,    1.0 },
+};
+
+struct Row {
+    std::string regime;
+    unsigned mask;
+    bool solvable;
+    double nsBest;
+    double nsMedian;
+    double iterations; // mean over the scenarios
+    double throughput; // scenarios per second at the best time
+};
+
+void printUsage() {
+    std::cerr << "usage: mathBench [options]\n"
+              << "  -n N                   scenarios per regime and mask (default 1000)\n"
+              << "  -r N                   timed rounds (default 5)\n"
+              << "  -p, --precision float|double  solver precision (default float)\n"
+              << "  --regime NAME          run a single regime\n"
+              << "  -f, --format text|csv|json    output format (default text)\n"
+              << "  --compare FILE         compare against an earlier --format csv run\n"
+              << "  --scaling N            time solveBatch of N scenarios on 1..-j workers\n"
+              << "  -j N                   most workers for --scaling (default: all cores)\n"
+              << "  --pin                  pin --scaling workers to cores\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!std::strcmp(arg, "-n") && value && std::atol(value) > 0) {
+            options.scenarios = (size_t)std::atol(value); i++;
+        } else if (!std::strcmp(arg, "-r") && value && std::atoi(value) > 0) {
+            options.rounds = std::atoi(value); i++;
+        } else if ((!std::strcmp(arg, "-p") || !std::strcmp(arg, "--precision")) && value) {
+            if (!std::strcmp(value, "float")) options.useDouble = false;
+            else if (!std::strcmp(value, "double")) options.useDouble = true;
+            else return false;
+            i++;
+        } else if ((!std::strcmp(arg, "-f") || !std::strcmp(arg, "--format")) && value) {
+            if (!std::strcmp(value, "text")) options.format = Format::Text;
+            else if (!std::strcmp(value, "csv")) options.format = Format::Csv;
+            else if (!std::strcmp(value, "json")) options.format = Format::Json;
+            else return false;
+            i++;
+        } else if (!std::strcmp(arg, "--regime") && value) {
+            options.regime = value; i++;
+        } else if (!std::strcmp(arg, "--compare") && value) {
+            options.compare = value; i++;
+        } else if (!std::strcmp(arg, "--scaling") && value && std::atol(value) > 0) {
+            options.scaling = (size_t)std::atol(value); i++;
+        } else if (!std::strcmp(arg, "-j") && value && std::atoi(value) > 0) {
+            options.maxThreads = (unsigned)std::atoi(value); i++;
+        } else if (!std::strcmp(arg, "--pin")) {
+            options.pinThreads = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string maskNames(unsigned mask) {
+    std::string names;
+    for (int i = 0; i < 8; i++) {
+        if (!(mask & (1u << i))) continue;
+        if (!names.empty()) names += '+';
+        names += VALUE_NAMES[i];
+    }
+    return names.empty() ? "none" : names;
+}
+
+// Ground-truth values in ArcaneMath order, theta in degrees
+template <typename T>
+std::vector<T> makeScenarios(const Regime& regime, size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto pick = [&](double lo, double hi) { return lo + (hi - lo) * unit(rng); };
+
+    std::vector<T> values(count * 8);
+    for (size_t i = 0; i < count; i++) {
+        double g = pick(9.0, 10.0);
+        double yi = pick(regime.yiMin, regime.yiMax);
+        double vi = pick(regime.viMin, regime.viMax);
+        double theta = pick(regime.thetaMin, regime.thetaMax);
+        double vx = vi * std::cos(theta * PI / 180.0);
+        double vy = vi * std::sin(theta * PI / 180.0);
+        double t = regime.timeFraction * pick(0.2, 1.0) * (2.0 * vy / g);
+        double vyEnd = vy - g * t;
+
+        T* row = &values[i * 8];
+        row[0] = (T)g;
+        row[1] = (T)yi;
+        row[2] = (T)(yi + vy * t - 0.5 * g * t * t);
+        row[3] = (T)vi;
+        row[4] = (T)std::sqrt(vx * vx + vyEnd * vyEnd);
+        row[5] = (T)(vx * t);
+        row[6] = (T)theta;
+        row[7] = (T)t;
+    }
+    return values;
+}
+
+template <typename T>
+Row benchMask(const Regime& regime, unsigned mask, std::vector<T>& scenarios,
+              size_t count, int rounds, double& checksum) {
+    bool known[8];
+    for (int i = 0; i < 8; i++) known[i] = (mask & (1u << i)) != 0;
+
+    std::vector<double> roundNs;
+    long iterations = 0;
+    for (int round = 0; round < rounds; round++) {
+        double sum = 0.0;
+        iterations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            ArcaneMath<T> math(&scenarios[i * 8], known);
+            math.solve();
+            iterations += math.getIterations();
+            T out[8];
+            math.writeToArray(out);
+            sum += (double)out[5] + (double)out[7];
+        }
+        auto stop = std::chrono::steady_clock::now();
+        roundNs.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / (double)count);
+        checksum += sum;
+    }
+    std::sort(roundNs.begin(), roundNs.end());
+
+    Row row;
+    row.regime = regime.name;
+    row.mask = mask;
+    row.solvable = ArcaneMath<T>::isSolvable(mask);
+    row.nsBest = roundNs.front();
+    row.nsMedian = roundNs[roundNs.size() / 2];
+    row.iterations = (double)iterations / (double)count;
+    row.throughput = row.nsBest > 0.0 ? 1e9 / row.nsBest : 0.0;
+    return row;
+}
+
+template <typename T>
+std::vector<Row> runBench(const Options& options, double& checksum) {
+    std::vector<Row> rows;
+    unsigned seed = 0;
+    for (const Regime& regime : REGIMES) {
+        seed++; // fixed per regime so --regime runs see the same inputs
+        if (options.regime && std::strcmp(options.regime, regime.name) != 0) continue;
+        std::vector<T> scenarios = makeScenarios<T>(regime, options.scenarios, seed);
+        for (unsigned mask = 0; mask < 256; mask++) {
+            rows.push_back(benchMask<T>(regime, mask, scenarios, options.scenarios, options.rounds, checksum));
+        }
+    }
+    return rows;
+}
+
+struct ScalingRow {
+    unsigned threads;
+    double msBest;
+    double throughput; // scenarios per second
+    double speedup;    // over one worker
+};
+
+// solveBatch over the whole batch, split by parallelFor, once per worker count
+template <typename T>
+std::vector<ScalingRow> runScaling(const Options& options, double& checksum) {
+    const size_t count = options.scaling;
+    std::vector<T> rows = makeScenarios<T>(REGIMES[0], count, 1);
+    // Column-major copy that every round starts from, since solving overwrites it
+    std::vector<T> source(count * 8);
+    for (size_t i = 0; i < count; i++) {
+        for (int k = 0; k < 8; k++) source[k * count + i] = rows[i * 8 + k];
+    }
+    std::vector<T> columns(count * 8);
+    std::vector<unsigned char> known(count);
+
+    unsigned maxThreads = options.maxThreads > 0 ? options.maxThreads : std::thread::hardware_concurrency();
+    maxThreads = std::max(maxThreads, 1u);
+    std::vector<ScalingRow> results;
+    for (unsigned threads = 1; threads <= maxThreads; threads++) {
+        SchedulerOptions pool;
+        pool.threads = threads;
+        pool.pinThreads = options.pinThreads;
+        TaskScheduler scheduler(pool);
+
+        double best = 0.0;
+        for (int round = 0; round <= options.rounds; round++) { // round 0 warms up
+            columns = source;
+            std::fill(known.begin(), known.end(), (unsigned char)SCALING_MASK);
+            auto start = std::chrono::steady_clock::now();
+            scheduler.parallelFor(0, count, [&](size_t first, size_t last) {
+                ArcaneBatch<T> batch;
+                batch.gravity = &columns[0 * count + first];
+                batch.yi = &columns[1 * count + first];
+                batch.yf = &columns[2 * count + first];
+                batch.vi = &columns[3 * count + first];
+                batch.vf = &columns[4 * count + first];
+                batch.d = &columns[5 * count + first];
+                batch.theta = &columns[6 * count + first];
+                batch.time = &columns[7 * count + first];
+                batch.known = &known[first];
+                batch.count = last - first;
+                ArcaneMath<T>::solveBatch(batch);
+            }, SCALING_GRAIN);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (round > 0 && (round == 1 || ms < best)) best = ms;
+        }
+        checksum += (double)columns[5 * count] + (double)columns[7 * count + count - 1];
+
+        ScalingRow row;
+        row.threads = threads;
+        row.msBest = best;
+        row.throughput = best > 0.0 ? (double)count / (best * 1e-3) : 0.0;
+        row.speedup = results.empty() ? 1.0 : results.front().msBest / std::max(best, 1e-9);
+        results.push_back(row);
+    }
+    return results;
+}
+
+void printScaling(const std::vector<ScalingRow>& rows, const Options& options) {
+    if (options.format == Format::Csv) {
+        std::printf("threads,ms_best,scenarios_per_s,speedup,efficiency\n");
+        for (const ScalingRow& row : rows) {
+            std::printf("%u,%.3f,%.0f,%.3f,%.3f\n", row.threads, row.msBest, row.throughput,
+                        row.speedup, row.speedup / row.threads);
+        }
+    } else if (options.format == Format::Json) {
+        std::printf("{\"precision\":\"%s\",\"scenarios\":%zu,\"rounds\":%d,\"scaling\":[\n",
+                    options.useDouble ? "double" : "float", options.scaling, options.rounds);
+        for (size_t i = 0; i < rows.size(); i++) {
+            const ScalingRow& row = rows[i];
+            std::printf("{\"threads\":%u,\"msBest\":%.3f,\"scenariosPerSecond\":%.0f,\"speedup\":%.3f,"
+                        "\"efficiency\":%.3f}%s\n", row.threads, row.msBest, row.throughput, row.speedup,
+                        row.speedup / row.threads, i + 1 < rows.size() ? "," : "");
+        }
+        std::printf("]}\n");
+    } else {
+        std::printf("mathBench scaling: %s, %zu scenarios (%s), best of %d rounds%s\n",
+                    options.useDouble ? "double" : "float", options.scaling, maskNames(SCALING_MASK).c_str(),
+                    options.rounds, options.pinThreads ? ", pinned" : "");
+        std::printf("%8s %10s %14s %9s %11s\n", "threads", "ms", "scenarios/s", "speedup", "efficiency");
+        for (const ScalingRow& row : rows) {
+            std::printf("%8u %10.2f %14.0f %8.2fx %10.0f%%\n", row.threads, row.msBest, row.throughput,
+                        row.speedup, 100.0 * row.speedup / row.threads);
+        }
+    }
+}
+
+// Mean ns/scenario of a set of rows, geometric so no single mask dominates
+double geoMean(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    double logSum = 0.0;
+    for (double v : values) logSum += std::log(std::max(v, 1e-3));
+    return std::exp(logSum / (double)values.size());
+}
+
+void printText(const std::vector<Row>& rows, const Options& options) {
+    std::printf("mathBench: %s, %zu scenarios x %d rounds per mask\n",
+                options.useDouble ? "double" : "float", options.scenarios, options.rounds);
+    std::printf("%-16s %10s %10s %10s %14s\n", "regime", "ns (geo)", "ns (max)", "iters", "scenarios/s");
+
+    std::map<std::string, std::vector<const Row*>> byRegime;
+    for (const Row& row : rows) byRegime[row.regime].push_back(&row);
+    for (const Regime& regime : REGIMES) {
+        auto found = byRegime.find(regime.name);
+        if (found == byRegime.end()) continue;
+        std::vector<double> ns;
+        double worst = 0.0, iterations = 0.0;
+        for (const Row* row : found->second) {
+            ns.push_back(row->nsBest);
+            worst = std::max(worst, row->nsBest);
+            iterations += row->iterations;
+        }
+        double mean = geoMean(ns);
+        std::printf("%-16s %10.1f %10.1f %10.2f %14.0f\n", regime.name, mean, worst,
+                    iterations / (double)found->second.size(), mean > 0.0 ? 1e9 / mean : 0.0);
+    }
+
+    std::vector<const Row*> slowest;
+    for (const Row& row : rows) slowest.push_back(&row);
+    size_t shown = std::min<size_t>(5, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + shown, slowest.end(),
+                      [](const Row* a, const Row* b) { return a->nsBest > b->nsBest; });
+    std::printf("\nslowest masks:\n");
+    for (size_t i = 0; i < shown; i++) {
+        const Row& row = *slowest[i];
+        std::printf("  %-16s 0x%02X %-40s %8.1f ns %6.2f iters\n", row.regime.c_str(), row.mask,
+                    maskNames(row.mask).c_str(), row.nsBest, row.iterations);
+    }
+}
+
+void printCsv(const std::vector<Row>& rows) {
+    std::printf("regime,mask,known,solvable,ns_best,ns_median,iterations,scenarios_per_s\n");
+    for (const Row& row : rows) {
+        std::printf("%s,%u,%s,%d,%.2f,%.2f,%.3f,%.0f\n", row.regime.c_str(), row.mask,
+                    maskNames(row.mask).c_str(), row.solvable ? 1 : 0, row.nsBest, row.nsMedian,
+                    row.iterations, row.throughput);
+    }
+}
+
+void printJson(const std::vector<Row>& rows, const Options& options) {
+    std::printf("{\"precision\":\"%s\",\"scenarios\":%zu,\"rounds\":%d,\"results\":[\n",
+                options.useDouble ? "double" : "float", options.scenarios, options.rounds);
+    for (size_t i = 0; i < rows.size(); i++) {
+        const Row& row = rows[i];
+        std::printf("{\"regime\":\"%s\",\"mask\":%u,\"known\":\"%s\",\"solvable\":%s,"
+                    "\"nsBest\":%.2f,\"nsMedian\":%.2f,\"iterations\":%.3f,\"scenariosPerSecond\":%.0f}%s\n",
+                    row.regime.c_str(), row.mask, maskNames(row.mask).c_str(),
+                    row.solvable ? "true" : "false", row.nsBest, row.nsMedian, row.iterations,
+                    row.throughput, i + 1 < rows.size() ? "," : "");
+    }
+    std::printf("]}\n");
+}
+
+// Per-regime geometric mean of new/baseline ns over the masks both runs have
+bool printComparison(const std::vector<Row>& rows, const char* path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: cannot open baseline '" << path << "'\n";
+        return false;
+    }
+    std::map<std::pair<std::string, unsigned>, double> baseline;
+    std::string line;
+    std::getline(in, line); // header
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string regime, mask, names, solvable, ns;
+        if (!std::getline(fields, regime, ',') || !std::getline(fields, mask, ',') ||
+            !std::getline(fields, names, ',') || !std::getline(fields, solvable, ',') ||
+            !std::getline(fields, ns, ',')) {
+            continue;
+        }
+        baseline[{ regime, (unsigned)std::atoi(mask.c_str()) }] = std::atof(ns.c_str());
+    }
+
+    std::fprintf(stderr, "\ncompared with %s (ratio < 1 is faster):\n", path);
+    for (const Regime& regime : REGIMES) {
+        std::vector<double> ratios;
+        for (const Row& row : rows) {
+            if (row.regime != regime.name) continue;
+            auto found = baseline.find({ row.regime, row.mask });
+            if (found != baseline.end() && found->second > 0.0) ratios.push_back(row.nsBest / found->second);
+        }
+        if (!ratios.empty()) {
+            std::fprintf(stderr, "  %-16s %6.3fx over %zu masks\n", regime.name, geoMean(ratios), ratios.size());
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    double checksum = 0.0;
+    if (options.scaling > 0) {
+        std::vector<ScalingRow> scaling = options.useDouble ? runScaling<double>(options, checksum)
+                                                            : runScaling<float>(options, checksum);
+        printScaling(scaling, options);
+        volatile double sink = checksum;
+        (void)sink;
+        return 0;
+    }
+
+    std::vector<Row> rows = options.useDouble ? runBench<double>(options, checksum)
+                                              : runBench<float>(options, checksum);
+    if (rows.empty()) {
+        std::cerr << "Error: unknown regime '" << options.regime << "'\n";
+        return 1;
+    }
+
+    if (options.format == Format::Csv) printCsv(rows);
+    else if (options.format == Format::Json) printJson(rows, options);
+    else printText(rows, options);
+
+    // Keeps the solves observable so they cannot be optimized away
+    volatile double sink = checksum;
+    (void)sink;
+
+    if (options.compare && !printComparison(rows, options.compare)) return 1;
+    return 0;
+}
@@ -1,6 +1,21 @@
+#include "../include/ArcaneIO.h"
+#include "../include/ArcaneJobs.h"
 #include "../include/ArcaneMath.h"
+#include "../include/ArcaneSampler.h"
+#include "../include/ArcaneScheduler.h"
+#include "../include/ArcaneTargeting.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
 
 int main() {
+    // Checks that print FAIL also set this, so the exit code reports them
+    bool failed = false;
+
     // Initialize arrays so unspecified entries are deterministic
     float data[8] = {0.0f};
     bool known[8] = {false};
@@ -54,4 +69,241 @@ int main() {
     test.solve();
     test.print();
 
-}
\ No newline at end of file
+    // Batch solve: one column per variable, one row per scenario
+    float gravity[3] = {9.8f, 0.0f, 0.0f};
+    float yi[3] = {0.0f, 0.0f, 0.0f};
+    float yf[3] = {0.0f, 0.0f, 0.0f};
+    float vi[3] = {0.0f, 20.0f, 20.0f};
+    float vf[3] = {0.0f, 0.0f, 0.0f};
+    float d[3] = {50.0f, 0.0f, 0.0f};
+    float theta[3] = {45.0f, 45.0f, 30.0f};
+    float time[3] = {10.0f, 0.0f, 0.0f};
+    unsigned char knownMask[3] = {
+        KNOWN_GRAVITY | KNOWN_D | KNOWN_THETA | KNOWN_TIME,
+        KNOWN_VI | KNOWN_THETA,
+        KNOWN_VI | KNOWN_THETA
+    };
+
+    ArcaneBatch<> batch;
+    batch.gravity = gravity; batch.yi = yi; batch.yf = yf; batch.vi = vi;
+    batch.vf = vf; batch.d = d; batch.theta = theta; batch.time = time;
+    batch.known = knownMask;
+    batch.count = 3;
+    ArcaneMath<>::solveBatch(batch);
+
+    for (int i = 0; i < 3; i++) {
+        std::cout << "batch[" << i << "] g = " << gravity[i] << ", yi = " << yi[i] << ", yf = " << yf[i]
+                  << ", vi = " << vi[i] << ", vf = " << vf[i] << ", d = " << d[i]
+                  << ", theta = " << theta[i] << ", t = " << time[i] << std::endl;
+    }
+
+    // Long, high-speed shot solved at float and double precision
+    double dataD[8] = {9.8, 0.0, 0.0, 3000.0, 0.0, 0.0, 60.0, 0.0};
+    bool knownD[8] = {true, true, false, true, false, false, true, false};
+    float dataF[8];
+    for (int i = 0; i < 8; i++) dataF[i] = (float)dataD[i];
+
+    ArcaneMath<float> longF(dataF, knownD);
+    longF.solve();
+    longF.print();
+    ArcaneMath<double> longD(dataD, knownD);
+    longD.solve();
+    longD.print();
+
+    // Which equations produce each value when only theta and vi are known
+    ArcaneMath<>::printPlan(KNOWN_VI | KNOWN_THETA);
+
+    // Both arcs through a target 30 m away at launch height, and the slowest shot
+    TargetSolution<float> target = solveTarget<float>(9.8f, 0.0f, 0.0f, 20.0f, 30.0f);
+    for (int i = 0; i < target.count; i++) {
+        std::cout << (i == 0 ? "low arc: theta = " : "high arc: theta = ") << target.arcs[i].theta
+                  << ", t = " << target.arcs[i].time << std::endl;
+    }
+    std::cout << "min speed " << target.minSpeed << " at theta = " << target.minSpeedTheta << std::endl;
+
+    // Pixel-error sampling of (near-)vertical shots, which go up and come back
+    // down along the same line: the apex must survive and the polyline must
+    // stay within the 0.5 px bound of the exact path
+    const float steepAngles[2] = { 90.0f, 89.9f };
+    const float viewScales[3] = { 5.0f, 20.0f, 200.0f };
+    TrajectorySampler sampler;
+    TrajectoryBuffers path;
+    for (float angle : steepAngles) {
+        for (float scale : viewScales) {
+            TrajectorySource source;
+            source.params.v0 = 40.0f;
+            source.params.theta = angle * (float)M_PI / 180.0f;
+            source.params.h0 = 50.0f;
+            source.params.g = 9.8f;
+            source.maxTime = 20.0f;
+            SamplePolicy policy;
+            policy.kind = SamplePolicy::PixelError;
+            policy.pxPerMeter = scale;
+            sampler.sample(source, policy, path);
+
+            const double vy = 40.0 * std::sin((double)source.params.theta);
+            const double vx = 40.0 * std::cos((double)source.params.theta);
+            const double apexTime = vy / 9.8;
+            const double apexY = 50.0 + vy * vy / (2.0 * 9.8);
+            float sampledTop = 0.0f;
+            for (size_t i = 0; i < path.count; i++) sampledTop = std::max(sampledTop, path.y[i]);
+            float apexX, apexYDrawn;
+            path.positionAt((float)apexTime, apexX, apexYDrawn);
+
+            // Furthest exact point from the sampled polyline, in pixels
+            double worst = 0.0;
+            for (int j = 0; j <= 2000; j++) {
+                double t = path.endTime * j / 2000.0;
+                double px = vx * t, py = 50.0 + vy * t - 4.9 * t * t;
+                double best = 1e30;
+                for (size_t i = 0; i + 1 < path.count; i++) {
+                    double ax = path.x[i], ay = path.y[i];
+                    double bx = path.x[i + 1] - ax, by = path.y[i + 1] - ay;
+                    double len2 = bx * bx + by * by;
+                    double f = len2 > 0.0 ? std::min(std::max(((px - ax) * bx + (py - ay) * by) / len2, 0.0), 1.0) : 0.0;
+                    best = std::min(best, std::hypot(px - ax - f * bx, py - ay - f * by));
+                }
+                worst = std::max(worst, best);
+            }
+            const bool withinBound = worst * scale <= 0.55;
+            failed |= !withinBound;
+            std::cout << "theta " << angle << " at " << scale << " px/m: " << path.count << " samples, top "
+                      << sampledTop << " m (apex " << apexY << " m), drawn at apex time " << apexYDrawn
+                      << " m, max error " << worst * scale << " px" << (withinBound ? "" : "  FAIL")
+                      << std::endl;
+        }
+    }
+
+    // Scheduler on more workers than cores, so steals and sleeps interleave:
+    // every index of a parallelFor runs exactly once, at any grain and over
+    // many runs; parallelFor nested in a worker finishes; a cancelled group
+    // skips the tasks that had not started
+    {
+        SchedulerOptions options;
+        options.threads = std::max(2 * std::thread::hardware_concurrency(), 8u);
+        TaskScheduler scheduler(options);
+
+        const size_t N = 100003;
+        std::vector<std::atomic<int>> visits(N);
+        int badRuns = 0;
+        const int RUNS = 50;
+        for (int run = 0; run < RUNS; run++) {
+            for (std::atomic<int>& v : visits) v.store(0, std::memory_order_relaxed);
+            // Grain 0 picks its own; the small ones split down to a few indices
+            scheduler.parallelFor(0, N, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; i++) visits[i].fetch_add(1, std::memory_order_relaxed);
+            }, (size_t)(run % 4) * 3);
+            bool once = true;
+            for (const std::atomic<int>& v : visits) once &= v.load(std::memory_order_relaxed) == 1;
+            if (!once) badRuns++;
+        }
+        failed |= badRuns > 0;
+        std::cout << "scheduler, " << scheduler.workerCount() << " workers: " << RUNS << " parallelFor runs over "
+                  << N << " indices, " << badRuns << " with an index missed or repeated"
+                  << (badRuns == 0 ? "" : "  FAIL") << std::endl;
+
+        std::atomic<size_t> inner{ 0 };
+        scheduler.parallelFor(0, 64, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                scheduler.parallelFor(0, 1000, [&](size_t a, size_t b) { inner.fetch_add(b - a); }, 16);
+            }
+        }, 1);
+        failed |= inner.load() != 64000;
+        std::cout << "nested parallelFor: " << inner.load() << " of 64000 inner indices"
+                  << (inner.load() == 64000 ? "" : "  FAIL") << std::endl;
+
+        // One worker held by the first task, so the rest are still queued
+        SchedulerOptions single;
+        single.threads = 1;
+        TaskScheduler one(single);
+        std::atomic<bool> release{ false };
+        std::atomic<int> ran{ 0 };
+        TaskGroup group(one);
+        group.run([&] { while (!release.load()) std::this_thread::yield(); });
+        for (int i = 0; i < 100; i++) group.run([&] { ran++; });
+        const bool timedOut = !group.waitFor(0.01);
+        group.cancel();
+        release = true;
+        group.wait();
+        const bool skipped = timedOut && ran.load() == 0;
+        failed |= !skipped;
+        std::cout << "cancelled group: waitFor timed out " << (timedOut ? "yes" : "no") << ", " << ran.load()
+                  << " of 100 queued tasks ran" << (skipped ? "" : "  FAIL") << std::endl;
+    }
+
+    // TripleBuffer handoff: what the consumer sees is never torn, never goes
+    // backwards, and ends on the producer's last publish
+    {
+        struct Value { long long n, check; };
+        TripleBuffer<Value> buffer;
+        buffer.front() = { 0, 0 };
+        const long long LAST = 200000;
+        std::thread producer([&] {
+            for (long long n = 1; n <= LAST; n++) {
+                buffer.back() = { n, -n };
+                buffer.publish();
+            }
+        });
+        long long seen = 0, updates = 0, bad = 0;
+        auto consume = [&] {
+            if (!buffer.update()) return;
+            updates++;
+            const Value& v = buffer.front();
+            if (v.check != -v.n || v.n <= seen) bad++;
+            seen = v.n;
+        };
+        while (seen < LAST && bad == 0) {
+            consume();
+            if (updates % 64 == 0) std::this_thread::yield();
+        }
+        producer.join();
+        consume();
+        const bool handedOff = bad == 0 && seen == LAST;
+        failed |= !handedOff;
+        std::cout << "triple buffer: " << updates << " updates for " << LAST << " publishes, last seen " << seen
+                  << (handedOff ? "" : "  FAIL") << std::endl;
+    }
+
+    // arcaneBatch's JSON-lines rows: cut-off input is reported malformed
+    // without reading past the line (each line is copied to an exact-size
+    // buffer so a sanitizer build catches overreads), and valid rows solve
+    {
+        const char* const COLUMNS[8] = { "gravity", "yi", "yf", "vi", "vf", "d", "theta", "time" };
+        struct JsonCase { const char* line; bool valid; };
+        const JsonCase cases[] = {
+            { "{\"gravity\": 9.8, \"yi\": 0, \"yf\": 0, \"vi\": 20, \"theta\": 45}", true },
+            { "{\"label\": \"say \\\"hi\\\"\", \"gravity\": 9.8, \"yi\": 0, \"yf\": 0, \"vi\": 20, \"theta\": 45, \"d\": null}", true },
+            { "{\"gravity\": 9.8, \"vi\": nul", false },
+            { "{\"gravity\": 9.8, \"label\": \"a\\", false },
+            { "{\"gravity\": 9.8, \"label\": \"abc", false },
+        };
+        for (const JsonCase& c : cases) {
+            std::vector<char> line(c.line, c.line + std::strlen(c.line));
+            double values[8] = { 0.0 };
+            unsigned found = 0;
+            const bool ok = parseJsonFields(line.data(), line.data() + line.size(), COLUMNS, 8, values, found);
+
+            unsigned char known = (unsigned char)found;
+            ArcaneBatch<double> batch;
+            batch.gravity = &values[0];
+            batch.yi = &values[1];
+            batch.yf = &values[2];
+            batch.vi = &values[3];
+            batch.vf = &values[4];
+            batch.d = &values[5];
+            batch.theta = &values[6];
+            batch.time = &values[7];
+            batch.known = &known;
+            batch.count = 1;
+            ArcaneMath<double>::solveBatch(batch);
+
+            // Malformed rows keep gravity, read before the damage
+            const bool pass = c.valid ? (ok && known == KNOWN_ALL) : (!ok && (found & KNOWN_GRAVITY));
+            failed |= !pass;
+            std::cout << "jsonl " << c.line << ": " << (ok ? "read" : "malformed") << ", "
+                      << (known == KNOWN_ALL ? "solved" : "not solved") << (pass ? "" : "  FAIL") << std::endl;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
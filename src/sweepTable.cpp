@@ -0,0 +1,168 @@
+#include "../include/ArcaneSweep.h"
+#include "../include/ArcaneIO.h"
+#include "../include/ArcaneScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Range/apex table generator: sweeps the (theta, vi, h0, g) grid given on the
+// command line and writes one CSV row per grid point, or the four dense float
+// arrays back to back with --raw.
+
+namespace {
+
+void printUsage() {
+    std::cerr << "usage: sweepTable --theta MIN:MAX:STEPS --vi MIN:MAX:STEPS [options]\n"
+              << "  --h0 MIN:MAX:STEPS     launch heights (default 0)\n"
+              << "  --g MIN:MAX:STEPS      gravities (default 9.8)\n"
+              << "  -o, --output FILE      write results to FILE (default stdout)\n"
+              << "  --raw                  write range, apex, time and impact speed arrays as float32\n"
+              << "  -t, --threads N        worker threads (default: all cores)\n"
+              << "  --pin                  pin worker threads to cores\n"
+              << "  --tile N               grid points per work item (default 16384)\n"
+              << "  --checkpoint FILE      save progress to FILE and resume from it\n"
+              << "  --checkpoint-every S   seconds between checkpoint writes (default 5)\n";
+}
+
+// "min:max:steps", or a single value for a one-step axis
+bool parseAxis(const char* text, SweepAxis& axis) {
+    if (!text) return false;
+    const char* end = text + std::strlen(text);
+    const char* p = text;
+    double min, max, steps;
+    if (!parseNumber(p, end, min)) return false;
+    if (p == end) {
+        axis.min = axis.max = (float)min;
+        axis.steps = 1;
+        return true;
+    }
+    if (*p++ != ':' || !parseNumber(p, end, max) || p == end || *p++ != ':' ||
+        !parseNumber(p, end, steps) || p != end || steps < 1.0) {
+        return false;
+    }
+    axis.min = (float)min;
+    axis.max = (float)max;
+    axis.steps = (size_t)steps;
+    return true;
+}
+
+bool writeCsv(const SweepSpec& spec, const SweepResults& results, FILE* out) {
+    ArcaneWriter writer(out);
+    const char header[] = "theta,vi,h0,g,range,apex,time,impactSpeed\n";
+    writer.write(header, sizeof(header) - 1);
+
+    for (size_t ig = 0; ig < spec.g.steps; ig++) {
+        for (size_t ih = 0; ih < spec.h0.steps; ih++) {
+            for (size_t iv = 0; iv < spec.vi.steps; iv++) {
+                for (size_t it = 0; it < spec.theta.steps; it++) {
+                    size_t p = spec.index(it, iv, ih, ig);
+                    const float values[8] = {
+                        spec.theta.at(it), spec.vi.at(iv), spec.h0.at(ih), spec.g.at(ig),
+                        results.range[p], results.apex[p], results.flightTime[p], results.impactSpeed[p]
+                    };
+                    char* text = writer.reserve(256);
+                    char* limit = text + 256;
+                    for (int k = 0; k < 8; k++) {
+                        if (k > 0) *text++ = ',';
+                        if (values[k] == values[k]) { // leave NaN (no landing) blank
+                            char* next = formatNumber(text, limit - 2, values[k]);
+                            if (next) text = next;
+                        }
+                    }
+                    *text++ = '\n';
+                    writer.commit(text);
+                }
+            }
+        }
+    }
+    writer.flush();
+    return !writer.failed();
+}
+
+bool writeRaw(const SweepResults& results, FILE* out) {
+    for (const std::vector<float>* array : { &results.range, &results.apex, &results.flightTime, &results.impactSpeed }) {
+        if (std::fwrite(array->data(), sizeof(float), array->size(), out) != array->size()) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SweepSpec spec;
+    spec.g.min = spec.g.max = 9.8f;
+    SweepOptions options;
+    SchedulerOptions pool;
+    const char* output = nullptr;
+    bool raw = false;
+    bool haveTheta = false, haveVi = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool ok = true;
+
+        if (!std::strcmp(arg, "--theta")) { ok = haveTheta = parseAxis(value, spec.theta); i++; }
+        else if (!std::strcmp(arg, "--vi")) { ok = haveVi = parseAxis(value, spec.vi); i++; }
+        else if (!std::strcmp(arg, "--h0")) { ok = parseAxis(value, spec.h0); i++; }
+        else if (!std::strcmp(arg, "--g")) { ok = parseAxis(value, spec.g); i++; }
+        else if (!std::strcmp(arg, "-o") || !std::strcmp(arg, "--output")) { output = value; ok = value != nullptr; i++; }
+        else if (!std::strcmp(arg, "--raw")) { raw = true; }
+        else if (!std::strcmp(arg, "--pin")) { pool.pinThreads = true; }
+        else if (!std::strcmp(arg, "-t") || !std::strcmp(arg, "--threads")) {
+            ok = value && std::atoi(value) > 0;
+            if (ok) options.threads = (unsigned)std::atoi(value);
+            i++;
+        } else if (!std::strcmp(arg, "--tile")) {
+            ok = value && std::atol(value) > 0;
+            if (ok) options.tileSize = (size_t)std::atol(value);
+            i++;
+        } else if (!std::strcmp(arg, "--checkpoint-every")) {
+            ok = value && std::atof(value) > 0.0;
+            if (ok) options.checkpointInterval = std::atof(value);
+            i++;
+        } else if (!std::strcmp(arg, "--checkpoint")) { options.checkpointPath = value; ok = value != nullptr; i++; }
+        else { ok = false; }
+
+        if (!ok) {
+            printUsage();
+            return 1;
+        }
+    }
+    if (!haveTheta || !haveVi) {
+        printUsage();
+        return 1;
+    }
+
+    pool.threads = options.threads;
+    TaskScheduler::configureShared(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    ArcaneSweep sweep(spec);
+    SweepResults results;
+    if (!sweep.run(results, options)) return 1;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "sweepTable: " << spec.count() << " grid points in " << seconds << " s";
+    if (seconds > 0.0) std::cerr << ", " << (size_t)(spec.count() / seconds) << " points/s";
+    std::cerr << "\n";
+
+    FILE* out = stdout;
+    if (output) {
+        out = std::fopen(output, "wb");
+        if (!out) {
+            std::cerr << "Error: cannot open output '" << output << "'\n";
+            return 1;
+        }
+    }
+    bool written = raw ? writeRaw(results, out) : writeCsv(spec, results, out);
+    // Buffered writes can still fail here (disk full, closed pipe)
+    if (out != stdout) written = std::fclose(out) == 0 && written;
+    else written = std::fflush(stdout) == 0 && written;
+    if (!written) {
+        std::cerr << "Error: failed writing output\n";
+        return 1;
+    }
+    return 0;
+}